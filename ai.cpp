@@ -1,13 +1,37 @@
 #include "ai.h"
-#include <limits>
+#include "zobrist.h"
+#include <cassert>
 #include <algorithm>
 #include <iostream>
+#include <thread>
+#include <type_traits>
 
-MancalaAI::MancalaAI(int difficulty) {
+namespace {
+    // The tablebase and the opening book are built for the standard board only
+    template <class Board>
+    bool isStandard() {
+        return std::is_same<Board, MancalaBoard>::value;
+    }
+    
+    bool probeEndgame(const EndgameTablebase& tablebase, const MancalaBoard& board, int& moverMargin) {
+        return tablebase.probe(board, moverMargin);
+    }
+    
+    // Never reached: other variants cannot load a tablebase
+    template <class Board>
+    bool probeEndgame(const EndgameTablebase&, const Board&, int&) {
+        return false;
+    }
+}
+
+template <class Board>
+BasicMancalaAI<Board>::BasicMancalaAI(int difficulty)
+    : threadCount(1), quiescence(true), lateMoveReductions(true), futilityPruning(true), razoring(true), wholeTurns(false), statsLog(nullptr), threads(1), hasDeadline(false), stopped(false), stopRequested(false) {
     setDifficulty(difficulty);
 }
 
-void MancalaAI::setDifficulty(int diff) {
+template <class Board>
+void BasicMancalaAI<Board>::setDifficulty(int diff) {
     difficulty = std::max(1, std::min(5, diff));  // Clamp between 1-5
     
     // Set the max search depth based on difficulty
@@ -21,133 +45,919 @@ void MancalaAI::setDifficulty(int diff) {
     }
 }
 
-int MancalaAI::findBestMove(const MancalaGame& game) {
-    MancalaGame* gameCopy = game.clone();
-    std::vector<int> possibleMoves = gameCopy->getPossibleMoves();
+template <class Board>
+void BasicMancalaAI<Board>::setSearchDepth(int depth) {
+    int limit = MAX_SEARCH_DEPTH;
+    maxDepth = std::max(1, std::min(limit, depth));
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setHashSize(size_t megabytes) {
+    transpositionTable.resize(megabytes);
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::clearSearchState() {
+    transpositionTable.clear();
+    for (SearchThread& thread : threads) {
+        thread.moveOrdering.clear();
+    }
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::saveHash(const std::string& path) const {
+    return transpositionTable.save(path, hashFileId());
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::loadHash(const std::string& path) {
+    return transpositionTable.load(path, hashFileId());
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setThreads(int count) {
+    threadCount = std::max(1, count);
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setQuiescence(bool enabled) {
+    quiescence = enabled;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setLateMoveReductions(bool enabled) {
+    lateMoveReductions = enabled;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setFutilityPruning(bool enabled) {
+    futilityPruning = enabled;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setRazoring(bool enabled) {
+    razoring = enabled;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setWholeTurns(bool enabled) {
+    // Table moves are pits in one mode and turn indices in the other
+    wholeTurns = enabled;
+    plannedTurn.clear();
+    clearSearchState();
+}
+
+template <class Board>
+double BasicMancalaAI<Board>::getHashHitRate() const {
+    return lastStats.hashHitRate();
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::findBestMove(const Board& board) {
+    // Fixed depth from the difficulty level, no time limit
+    hasDeadline = false;
+    return startSearch(board, maxDepth);
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::findBestMove(const Board& board, std::chrono::milliseconds budget) {
+    // Deepen until the budget runs out
+    hasDeadline = true;
+    deadline = std::chrono::steady_clock::now() + budget;
+    return startSearch(board, MAX_SEARCH_DEPTH);
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::findBestMove(const Board& board, SearchStats& stats) {
+    int move = findBestMove(board);
+    stats = lastStats;
+    return move;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::findBestMove(const Board& board, std::chrono::milliseconds budget, SearchStats& stats) {
+    int move = findBestMove(board, budget);
+    stats = lastStats;
+    return move;
+}
+
+template <class Board>
+const SearchStats& BasicMancalaAI<Board>::getLastSearchStats() const {
+    return lastStats;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::setStatsLog(std::ostream* log) {
+    statsLog = log;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::stop() {
+    stopRequested = true;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::resetStop() {
+    stopRequested = false;
+}
+
+template <class Board>
+uint64_t BasicMancalaAI<Board>::getTablebaseHits() const {
+    return lastStats.tablebaseHits;
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::loadOpeningBook(const std::string& path) {
+    return isStandard<Board>() && openingBook.open(path);
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::lastMoveFromBook() const {
+    return lastStats.bookMove;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::getLastSearchDepth() const {
+    return lastStats.completedDepth;
+}
+
+template <class Board>
+uint64_t BasicMancalaAI<Board>::getLastSearchNodes() const {
+    return lastStats.nodes;
+}
+
+template <class Board>
+double BasicMancalaAI<Board>::getFirstMoveCutoffRate() const {
+    return lastStats.firstMoveCutoffRate();
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::startSearch(const Board& board, int depthLimit) {
+    searchStart = std::chrono::steady_clock::now();
+    lastStats = SearchStats();
+    
+    int move = runSearch(board, depthLimit);
+    collectStats(move);
     
-    if (possibleMoves.empty()) {
-        delete gameCopy;
+    if (statsLog != nullptr) {
+        lastStats.writeJson(*statsLog);
+        statsLog->flush();
+    }
+    return move;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::collectStats(int move) {
+    lastStats.move = move;
+    lastStats.threads = static_cast<int>(threads.size());
+    lastStats.completedDepth = threads[0].completedDepth;
+    lastStats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - searchStart).count();
+    
+    for (const SearchThread& thread : threads) {
+        lastStats.nodes += thread.nodes;
+        lastStats.leaves += thread.leaves;
+        lastStats.quiescenceNodes += thread.quiescenceNodes;
+        lastStats.reductions += thread.reductions;
+        lastStats.reSearches += thread.reSearches;
+        lastStats.futilityPrunes += thread.futilityPrunes;
+        lastStats.razorCuts += thread.razorCuts;
+        lastStats.cutoffs += thread.cutoffs;
+        lastStats.firstMoveCutoffs += thread.firstMoveCutoffs;
+        lastStats.hashProbes += thread.hashProbes;
+        lastStats.hashHits += thread.hashHits;
+        lastStats.tablebaseHits += thread.tablebaseHits;
+        lastStats.maxPly = std::max(lastStats.maxPly, thread.maxPly);
+    }
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::runSearch(const Board& board, int depthLimit) {
+    stopped = false;
+    
+    threads.resize(threadCount);
+    for (size_t i = 0; i < threads.size(); i++) {
+        SearchThread& thread = threads[i];
+        thread.board = board;
+        thread.hash = Zobrist::hash(board);
+        thread.features = Features::compute(board);
+        thread.moveOrdering.age();
+        thread.turnLists.resize(MAX_SEARCH_DEPTH + 1);
+        thread.iterationTurn = -1;
+        thread.bestTurn = -1;
+        thread.isMain = (i == 0);
+        thread.completedDepth = 0;
+        thread.nodes = 0;
+        thread.cutoffs = 0;
+        thread.firstMoveCutoffs = 0;
+        thread.hashProbes = 0;
+        thread.hashHits = 0;
+        thread.tablebaseHits = 0;
+        thread.leaves = 0;
+        thread.quiescenceNodes = 0;
+        thread.reductions = 0;
+        thread.reSearches = 0;
+        thread.futilityPrunes = 0;
+        thread.razorCuts = 0;
+        thread.maxPly = 0;
+    }
+    
+    int possibleMoves[Board::PITS_PER_PLAYER];
+    int moveCount = board.getPossibleMoves(possibleMoves);
+    
+    if (moveCount == 0) {
         return -1;  // No valid moves
     }
     
-    int bestScore = std::numeric_limits<int>::min();
+    // Nothing to think about with a single legal move under a time limit
+    if (moveCount == 1 && hasDeadline) {
+        return possibleMoves[0];
+    }
+    
+    // The rest of a whole turn was decided by the search that chose it
+    int planned = plannedSowing(board, threads[0].hash);
+    if (planned >= 0) {
+        lastStats.plannedMove = true;
+        return planned;
+    }
+    
+    // Opening positions were searched offline, used when the search would
+    // have gone at least as deep
+    int bookMove = openingBook.probe(threads[0].hash, depthLimit);
+    if (bookMove >= 0 && board.isValidMove(bookMove)) {
+        lastStats.bookMove = true;
+        return bookMove;
+    }
+    
+    // Results of earlier searches stay in the table, but make way for new ones first
+    transpositionTable.newSearch();
+    
+    // Helper threads fill the shared table; odd helpers run one ply ahead of
+    // the main thread so the threads do not all search the same tree
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < threads.size(); i++) {
+        int startDepth = 1 + static_cast<int>(i % 2);
+        helpers.emplace_back([this, i, startDepth, depthLimit]() {
+            iterativeDeepening(threads[i], startDepth, depthLimit);
+        });
+    }
+    
+    int bestMove = iterativeDeepening(threads[0], 1, depthLimit);
+    
+    // The main thread is done, release the helpers
+    stopped = true;
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+    
+    // Remember the rest of the chosen turn, the root list is the same every iteration
+    if (wholeTurns && threads[0].bestTurn >= 0) {
+        const BasicTurn<Board>& turn = threads[0].turnLists[0].turns[threads[0].bestTurn];
+        Board next = board;
+        uint64_t hash = threads[0].hash;
+        for (int i = 0; i + 1 < turn.length; i++) {
+            typename Board::Undo undo;
+            Features features = Features::compute(next);
+            next.makeMove(turn.sowings[i], undo, hash, features);
+            plannedTurn.push_back(PlannedSowing{hash, turn.sowings[i + 1]});
+        }
+    }
+    
+    return bestMove;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::plannedSowing(const Board& board, uint64_t hash) {
+    if (plannedTurn.empty() || plannedTurn.front().hash != hash || !board.isValidMove(plannedTurn.front().pit)) {
+        plannedTurn.clear();
+        return -1;
+    }
+    
+    int pit = plannedTurn.front().pit;
+    plannedTurn.erase(plannedTurn.begin());
+    return pit;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::iterativeDeepening(SearchThread& thread, int startDepth, int depthLimit) {
+    int possibleMoves[Board::PITS_PER_PLAYER];
+    thread.board.getPossibleMoves(possibleMoves);
     int bestMove = possibleMoves[0];  // Default to first move
+    int bestScore = 0;
+    
+    // Search scores are for the side to move, reported scores for Player 2
+    int sign = thread.board.isPlayer1Turn() ? -1 : 1;
     
-    // Try each possible move and evaluate with minimax
-    for (int move : possibleMoves) {
-        MancalaGame* moveSimulation = gameCopy->clone();
-        bool extraTurn = false;
+    for (int depth = startDepth; depth <= depthLimit; depth++) {
+        int iterationMove = bestMove;
+        int iterationScore = 0;
+        uint64_t iterationStartNodes = thread.nodes;
+        
+        // After the first iteration, search a narrow window around the
+        // previous score and widen it on the side that failed until the
+        // score falls inside
+        int delta = ASPIRATION_WINDOW;
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        if (thread.completedDepth > 0) {
+            alpha = std::max(bestScore - delta, -INFINITE_SCORE);
+            beta = std::min(bestScore + delta, INFINITE_SCORE);
+        }
+        
+        bool completed;
+        for (;;) {
+            completed = searchRoot(thread, depth, alpha, beta, iterationMove, iterationScore);
+            if (!completed) {
+                break;
+            }
+            
+            delta *= 2;
+            if (iterationScore <= alpha && alpha > -INFINITE_SCORE) {
+                alpha = std::max(iterationScore - delta, -INFINITE_SCORE);
+            } else if (iterationScore >= beta && beta < INFINITE_SCORE) {
+                beta = std::min(iterationScore + delta, INFINITE_SCORE);
+            } else {
+                break;
+            }
+        }
+        
+        // Only results of completed iterations are used
+        if (!completed) {
+            break;
+        }
+        
+        bestMove = iterationMove;
+        bestScore = iterationScore;
+        thread.bestTurn = thread.iterationTurn;
+        thread.completedDepth = depth;
+        
+        if (thread.isMain) {
+            IterationStats iteration;
+            iteration.depth = depth;
+            iteration.move = iterationMove;
+            iteration.score = sign * iterationScore;
+            iteration.nodes = thread.nodes - iterationStartNodes;
+            iteration.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - searchStart).count();
+            lastStats.iterations.push_back(iteration);
+        }
+        
+        // A proven win or loss will not change with more depth
+        if (iterationScore >= WIN_SCORE || iterationScore <= -WIN_SCORE) {
+            break;
+        }
+    }
+    
+    return bestMove;
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::searchRoot(SearchThread& thread, int depth, int alpha, int beta, int& bestMove, int& bestScore) {
+    if (wholeTurns) {
+        return searchRootTurns(thread, depth, alpha, beta, bestMove, bestScore);
+    }
+    
+    Board& board = thread.board;
+    
+    int possibleMoves[Board::PITS_PER_PLAYER];
+    int moveCount = board.getPossibleMoves(possibleMoves);
+    
+    // Start with the best move of the previous iteration
+    thread.moveOrdering.orderMoves(board, possibleMoves, moveCount, bestMove, 0);
+    
+    bestScore = -INFINITE_SCORE;
+    
+    // Try each possible move; every root move reduces the depth, extra turn or not
+    for (int i = 0; i < moveCount; i++) {
+        int move = possibleMoves[i];
+        typename Board::Undo undo;
+        Features features = thread.features;
         
         // Make the move
-        moveSimulation->makeMove(move);
+        board.makeMove(move, undo, thread.hash, thread.features);
+        bool gotExtraTurn = !undo.turnFlipped;
+        
+        int score = searchMove(thread, depth - 1, 1, alpha, beta, gotExtraTurn, i == 0);
         
-        // Evaluate the resulting position
-        bool getExtraTurn = false;
-        int score = minimax(moveSimulation, maxDepth - 1, false, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), getExtraTurn);
+        board.unmakeMove(undo, thread.hash);
+        thread.features = features;
+        
+        if (stopped.load(std::memory_order_relaxed)) {
+            return false;
+        }
         
         // Update best move if this is better
         if (score > bestScore) {
             bestScore = score;
             bestMove = move;
         }
+        alpha = std::max(alpha, bestScore);
         
-        delete moveSimulation;
+        // Fail high of an aspiration window, the caller widens it
+        if (beta <= alpha) {
+            break;
+        }
     }
     
-    delete gameCopy;
-    return bestMove;
+    return true;
 }
 
-int MancalaAI::minimax(MancalaGame* game, int depth, bool isMaximizing, int alpha, int beta, bool& getExtraTurn) {
-    // Terminal conditions
-    if (depth == 0 || game->isGameOver()) {
-        getExtraTurn = false;
-        return evaluateBoard(*game);
+template <class Board>
+void BasicMancalaAI<Board>::recordCutoff(SearchThread& thread, int move, int moveIndex, int ply, int depth) {
+    thread.cutoffs++;
+    thread.firstMoveCutoffs += moveIndex == 0;
+    thread.moveOrdering.recordCutoff(thread.board, move, ply, depth);
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::timeUp(SearchThread& thread) {
+    if (stopped.load(std::memory_order_relaxed)) {
+        return true;
     }
     
-    std::vector<int> possibleMoves = game->getPossibleMoves();
+    if (stopRequested.load(std::memory_order_relaxed)) {
+        stopped = true;
+        return true;
+    }
     
-    // No valid moves
-    if (possibleMoves.empty()) {
-        getExtraTurn = false;
-        return evaluateBoard(*game);
+    // Looking at the clock is comparatively slow, so only do it every few thousand nodes
+    if (thread.isMain && hasDeadline && thread.completedDepth > 0 &&
+        (thread.nodes & TIME_CHECK_INTERVAL) == 0 &&
+        std::chrono::steady_clock::now() >= deadline) {
+        stopped = true;
+        return true;
+    }
+    return false;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::searchMove(SearchThread& thread, int depth, int ply, int alpha, int beta, bool extraTurn, bool firstMove) {
+    // The first move gets the full window. Later ones only have to be shown
+    // no better than alpha, with a null window around it, and are searched
+    // again with the full window if that fails.
+    if (!firstMove) {
+        int score = searchChild(thread, depth, ply, alpha, alpha + 1, extraTurn);
+        if (score <= alpha || score >= beta) {
+            return score;
+        }
+    }
+    return searchChild(thread, depth, ply, alpha, beta, extraTurn);
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::searchChild(SearchThread& thread, int depth, int ply, int alpha, int beta, bool extraTurn) {
+    // After an extra turn the same side is still to move
+    if (wholeTurns) {
+        return extraTurn ? negamaxTurns(thread, depth, ply, alpha, beta) : -negamaxTurns(thread, depth, ply, -beta, -alpha);
+    }
+    if (extraTurn) {
+        return negamax(thread, depth, ply, alpha, beta);
+    }
+    return -negamax(thread, depth, ply, -beta, -alpha);
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::generateTurns(SearchThread& thread, TurnList& list, int first) {
+    thread.turnGenerator.generate(thread.board, thread.hash, thread.features, list.turns);
+    
+    // Best static score for the mover first; the search is ordered well
+    // enough by it that killers and history are not used for turns
+    int count = static_cast<int>(list.turns.size());
+    int sign = thread.board.isPlayer1Turn() ? -1 : 1;
+    list.scores.resize(count);
+    list.order.resize(count);
+    for (int i = 0; i < count; i++) {
+        const BasicTurn<Board>& turn = list.turns[i];
+        list.scores[i] = i == first ? INFINITE_SCORE : sign * evaluateFeatures(turn.board, turn.features);
+        list.order[i] = i;
     }
+    std::stable_sort(list.order.begin(), list.order.end(), [&list](int a, int b) {
+        return list.scores[a] > list.scores[b];
+    });
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::searchRootTurns(SearchThread& thread, int depth, int alpha, int beta, int& bestMove, int& bestScore) {
+    TurnList& list = thread.turnLists[0];
+    generateTurns(thread, list, thread.bestTurn);
     
-    if (isMaximizing) {  // AI's turn (maximizing)
-        int bestScore = std::numeric_limits<int>::min();
+    Board board = thread.board;
+    uint64_t hash = thread.hash;
+    Features features = thread.features;
+    bestScore = -INFINITE_SCORE;
+    
+    for (size_t i = 0; i < list.order.size(); i++) {
+        const BasicTurn<Board>& turn = list.turns[list.order[i]];
+        thread.board = turn.board;
+        thread.hash = turn.hash;
+        thread.features = turn.features;
         
-        for (int move : possibleMoves) {
-            MancalaGame* moveSimulation = game->clone();
-            bool extraTurn = false;
-            
-            // Make the move and check if it results in an extra turn
-            bool moveSuccess = moveSimulation->makeMove(move);
-            bool gotExtraTurn = moveSuccess && moveSimulation->isPlayer1Turn() == game->isPlayer1Turn();
-            
-            bool dummyExtraTurn = false;
-            int score;
-            
-            // If we get an extra turn, it's still our turn (maximizing)
-            if (gotExtraTurn) {
-                score = minimax(moveSimulation, depth, true, alpha, beta, dummyExtraTurn);
+        // Only a turn that ends the game leaves the same side to move
+        bool sameSide = turn.board.isPlayer1Turn() == board.isPlayer1Turn();
+        int score = searchMove(thread, depth - 1, 1, alpha, beta, sameSide, i == 0);
+        
+        thread.board = board;
+        thread.hash = hash;
+        thread.features = features;
+        
+        if (stopped.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = turn.sowings[0];
+            thread.iterationTurn = list.order[i];
+        }
+        alpha = std::max(alpha, bestScore);
+        
+        // Fail high of an aspiration window, the caller widens it
+        if (beta <= alpha) {
+            break;
+        }
+    }
+    
+    return true;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::negamaxTurns(SearchThread& thread, int depth, int ply, int alpha, int beta) {
+    int sign = thread.board.isPlayer1Turn() ? -1 : 1;
+    thread.nodes++;
+    SEARCH_STAT(thread.maxPly = std::max(thread.maxPly, ply));
+    
+    if (timeUp(thread)) {
+        return 0;
+    }
+    
+    int tablebaseScore;
+    if (probeTablebase(thread.board, thread.features, tablebaseScore)) {
+        thread.tablebaseHits++;
+        return sign * tablebaseScore;
+    }
+    
+    if (isGameOver(thread.features) || (depth == 0 && !quiescence)) {
+        SEARCH_STAT(thread.leaves++);
+        return sign * evaluateFeatures(thread.board, thread.features);
+    }
+    if (depth == 0) {
+        return quiesce(thread, ply, alpha, beta);
+    }
+    
+    bool useTable = depth >= TT_MIN_DEPTH;
+    int alphaOrig = alpha;
+    int betaOrig = beta;
+    int ttTurn = -1;
+    TTEntry entry;
+    thread.hashProbes += useTable;
+    if (useTable && transpositionTable.probe(thread.hash, entry)) {
+        thread.hashHits++;
+        ttTurn = entry.move;
+        if (entry.depth >= depth) {
+            if (entry.bound == Bound::EXACT) {
+                return entry.score;
+            } else if (entry.bound == Bound::LOWER) {
+                alpha = std::max(alpha, static_cast<int>(entry.score));
             } else {
-                score = minimax(moveSimulation, depth - 1, false, alpha, beta, dummyExtraTurn);
+                beta = std::min(beta, static_cast<int>(entry.score));
             }
-            
-            delete moveSimulation;
-            
-            bestScore = std::max(bestScore, score);
-            alpha = std::max(alpha, bestScore);
-            
             if (beta <= alpha) {
-                break;  // Beta cutoff
+                return entry.score;
             }
         }
+    }
+    
+    TurnList& list = thread.turnLists[ply];
+    generateTurns(thread, list, ttTurn);
+    if (list.turns.empty()) {
+        SEARCH_STAT(thread.leaves++);
+        return sign * evaluateFeatures(thread.board, thread.features);
+    }
+    
+    Board board = thread.board;
+    uint64_t hash = thread.hash;
+    Features features = thread.features;
+    int bestScore = -INFINITE_SCORE;
+    int bestTurn = list.order[0];
+    
+    for (size_t i = 0; i < list.order.size(); i++) {
+        const BasicTurn<Board>& turn = list.turns[list.order[i]];
+        thread.board = turn.board;
+        thread.hash = turn.hash;
+        thread.features = turn.features;
         
-        return bestScore;
-    } else {  // Human's turn (minimizing)
-        int bestScore = std::numeric_limits<int>::max();
+        bool sameSide = turn.board.isPlayer1Turn() == board.isPlayer1Turn();
+        int score = searchMove(thread, depth - 1, ply + 1, alpha, beta, sameSide, i == 0);
         
-        for (int move : possibleMoves) {
-            MancalaGame* moveSimulation = game->clone();
-            bool extraTurn = false;
-            
-            // Make the move and check if it results in an extra turn
-            bool moveSuccess = moveSimulation->makeMove(move);
-            bool gotExtraTurn = moveSuccess && moveSimulation->isPlayer1Turn() == game->isPlayer1Turn();
-            
-            bool dummyExtraTurn = false;
-            int score;
-            
-            // If we get an extra turn, it's still the opponent's turn (minimizing)
-            if (gotExtraTurn) {
-                score = minimax(moveSimulation, depth, false, alpha, beta, dummyExtraTurn);
+        thread.board = board;
+        thread.hash = hash;
+        thread.features = features;
+        
+        if (stopped.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        
+        if (score > bestScore) {
+            bestScore = score;
+            bestTurn = list.order[i];
+        }
+        alpha = std::max(alpha, bestScore);
+        
+        if (beta <= alpha) {
+            thread.cutoffs++;
+            thread.firstMoveCutoffs += i == 0;
+            break;
+        }
+    }
+    
+    if (useTable) {
+        Bound bound = Bound::EXACT;
+        if (bestScore <= alphaOrig) {
+            bound = Bound::UPPER;
+        } else if (bestScore >= betaOrig) {
+            bound = Bound::LOWER;
+        }
+        transpositionTable.store(thread.hash, depth, bound, bestScore, bestTurn <= INT8_MAX ? bestTurn : -1);
+    }
+    
+    return bestScore;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::negamax(SearchThread& thread, int depth, int ply, int alpha, int beta) {
+    Board& board = thread.board;
+    int sign = board.isPlayer1Turn() ? -1 : 1;
+    thread.nodes++;
+    SEARCH_STAT(thread.maxPly = std::max(thread.maxPly, ply));
+    
+    // Unwind without a result once the search is stopped
+    if (timeUp(thread)) {
+        return 0;
+    }
+    
+#ifdef MANCALA_VERIFY_EVAL
+    // Debug builds check the incremental features against a full rescan
+    assert(thread.features.matches(board));
+    assert(evaluateFeatures(board, thread.features) == evaluateBoard(board));
+#endif
+    
+    // Exact result once few enough stones are left for the endgame tablebase
+    int tablebaseScore;
+    if (probeTablebase(board, thread.features, tablebaseScore)) {
+        thread.tablebaseHits++;
+        return sign * tablebaseScore;
+    }
+    
+    // Terminal conditions
+    if (isGameOver(thread.features) || (depth == 0 && !quiescence)) {
+        SEARCH_STAT(thread.leaves++);
+        return sign * evaluateFeatures(board, thread.features);
+    }
+    
+    // Resolve pending extra turns and captures before evaluating
+    if (depth == 0) {
+        return quiesce(thread, ply, alpha, beta);
+    }
+    
+    // Reuse an earlier result for this position if it was searched deep enough.
+    // Nodes just above the leaves are cheaper to search than to look up.
+    bool useTable = depth >= TT_MIN_DEPTH;
+    int alphaOrig = alpha;
+    int betaOrig = beta;
+    int ttMove = -1;
+    TTEntry entry;
+    thread.hashProbes += useTable;
+    if (useTable && transpositionTable.probe(thread.hash, entry)) {
+        thread.hashHits++;
+        ttMove = entry.move;
+        if (entry.depth >= depth) {
+            if (entry.bound == Bound::EXACT) {
+                return entry.score;
+            } else if (entry.bound == Bound::LOWER) {
+                alpha = std::max(alpha, static_cast<int>(entry.score));
             } else {
-                score = minimax(moveSimulation, depth - 1, true, alpha, beta, dummyExtraTurn);
+                beta = std::min(beta, static_cast<int>(entry.score));
             }
-            
-            delete moveSimulation;
-            
-            bestScore = std::min(bestScore, score);
-            beta = std::min(beta, bestScore);
-            
             if (beta <= alpha) {
-                break;  // Alpha cutoff
+                return entry.score;
+            }
+        }
+    }
+    
+    // Selective search stays off the principal variation and away from
+    // proven wins and losses; judged by the window the node was called with,
+    // not one a stored bound narrowed
+    bool selective = betaOrig - alphaOrig == 1 && alphaOrig > -WIN_SCORE / 2 && betaOrig < WIN_SCORE / 2;
+    int staticScore = 0;
+    if (selective && depth <= std::max(FUTILITY_DEPTH, RAZOR_DEPTH)) {
+        staticScore = sign * evaluateFeatures(board, thread.features);
+    }
+    
+    // Razoring: so far below alpha that only tactics could help, which the
+    // quiescence search covers
+    if (selective && razoring && quiescence && depth <= RAZOR_DEPTH && staticScore + RAZOR_MARGIN * depth <= alpha) {
+        int score = quiesce(thread, ply, alpha, beta);
+        if (score <= alpha) {
+            SEARCH_STAT(thread.razorCuts++);
+            return score;
+        }
+    }
+    
+    // Futility: no quiet move makes up the distance to alpha
+    bool futile = selective && futilityPruning && depth <= FUTILITY_DEPTH && staticScore + FUTILITY_MARGIN * depth <= alpha;
+    
+    int possibleMoves[Board::PITS_PER_PLAYER];
+    int moveCount = board.getPossibleMoves(possibleMoves);
+    
+    // No valid moves
+    if (moveCount == 0) {
+        SEARCH_STAT(thread.leaves++);
+        return sign * evaluateFeatures(board, thread.features);
+    }
+    
+    // Stored best move first, then extra turns, captures, killers and history
+    thread.moveOrdering.orderMoves(board, possibleMoves, moveCount, ttMove, ply);
+    
+    int bestScore = -INFINITE_SCORE;
+    int bestMove = possibleMoves[0];
+    bool pruned = false;
+    
+    for (int i = 0; i < moveCount; i++) {
+        int move = possibleMoves[i];
+        bool quiet = !BasicMoveOrdering<Board>::isExtraTurn(board, move) && BasicMoveOrdering<Board>::captureSize(board, move) == 0;
+        if (futile && quiet && i > 0) {
+            SEARCH_STAT(thread.futilityPrunes++);
+            pruned = true;
+            continue;
+        }
+        
+        typename Board::Undo undo;
+        Features features = thread.features;
+        
+        // Make the move and check if it results in an extra turn
+        board.makeMove(move, undo, thread.hash, thread.features);
+        bool gotExtraTurn = !undo.turnFlipped;
+        
+        // An extra turn continues the same turn at the same depth
+        int childDepth = gotExtraTurn ? depth : depth - 1;
+        int score;
+        if (selective && lateMoveReductions && quiet && !gotExtraTurn && depth >= LMR_MIN_DEPTH && i >= LMR_FIRST_MOVE) {
+            // Reduced null-window search first, verified at full depth if it beats alpha
+            SEARCH_STAT(thread.reductions++);
+            score = searchChild(thread, childDepth - 1, ply + 1, alpha, alpha + 1, false);
+            if (score > alpha && !stopped.load(std::memory_order_relaxed)) {
+                SEARCH_STAT(thread.reSearches++);
+                score = searchMove(thread, childDepth, ply + 1, alpha, beta, false, false);
             }
+        } else {
+            score = searchMove(thread, childDepth, ply + 1, alpha, beta, gotExtraTurn, i == 0);
+        }
+        
+        board.unmakeMove(undo, thread.hash);
+        thread.features = features;
+        
+        if (stopped.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
         }
+        alpha = std::max(alpha, bestScore);
         
+        if (beta <= alpha) {
+            recordCutoff(thread, move, i, ply, depth);
+            break;  // Beta cutoff
+        }
+    }
+    
+    // A skipped move may have scored up to the futility margin, so that is
+    // as low as the upper bound can go
+    if (pruned) {
+        bestScore = std::max(bestScore, staticScore + FUTILITY_MARGIN * depth);
+    }
+    
+    // Scores outside the original window are only bounds
+    if (useTable) {
+        Bound bound = Bound::EXACT;
+        if (bestScore <= alphaOrig) {
+            bound = Bound::UPPER;
+        } else if (bestScore >= betaOrig) {
+            bound = Bound::LOWER;
+        }
+        transpositionTable.store(thread.hash, depth, bound, bestScore, bestMove);
+    }
+    
+    return bestScore;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::quiesce(SearchThread& thread, int ply, int alpha, int beta) {
+    Board& board = thread.board;
+    int sign = board.isPlayer1Turn() ? -1 : 1;
+    SEARCH_STAT(thread.quiescenceNodes++);
+    SEARCH_STAT(thread.maxPly = std::max(thread.maxPly, ply));
+    
+    if (timeUp(thread)) {
+        return 0;
+    }
+    
+    int tablebaseScore;
+    if (probeTablebase(board, thread.features, tablebaseScore)) {
+        thread.tablebaseHits++;
+        return sign * tablebaseScore;
+    }
+    
+    // Standing pat: the side to move can always fall back on a quiet move,
+    // so the static score is a lower bound
+    SEARCH_STAT(thread.leaves++);
+    int bestScore = sign * evaluateQuiet(board, thread.features);
+    if (bestScore >= beta || isGameOver(thread.features)) {
         return bestScore;
     }
+    alpha = std::max(alpha, bestScore);
+    
+    // Only the moves that change the material balance. Each one puts at
+    // least one more stone into a store, so the search always ends.
+    int possibleMoves[Board::PITS_PER_PLAYER];
+    int moveCount = board.getPossibleMoves(possibleMoves);
+    int tacticalCount = 0;
+    for (int i = 0; i < moveCount; i++) {
+        int pit = possibleMoves[i];
+        if (BasicMoveOrdering<Board>::isExtraTurn(board, pit) || BasicMoveOrdering<Board>::captureSize(board, pit) > 0) {
+            possibleMoves[tacticalCount++] = pit;
+        }
+    }
+    
+    thread.moveOrdering.orderMoves(board, possibleMoves, tacticalCount, -1, ply);
+    
+    for (int i = 0; i < tacticalCount; i++) {
+        typename Board::Undo undo;
+        Features features = thread.features;
+        
+        board.makeMove(possibleMoves[i], undo, thread.hash, thread.features);
+        thread.nodes++;
+        
+        // After an extra turn the same side is still to move
+        int score = undo.turnFlipped ? -quiesce(thread, ply + 1, -beta, -alpha) : quiesce(thread, ply + 1, alpha, beta);
+        
+        board.unmakeMove(undo, thread.hash);
+        thread.features = features;
+        
+        if (stopped.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        
+        bestScore = std::max(bestScore, score);
+        alpha = std::max(alpha, bestScore);
+        if (beta <= alpha) {
+            thread.cutoffs++;
+            thread.firstMoveCutoffs += i == 0;
+            break;
+        }
+    }
+    
+    return bestScore;
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::loadTablebase(const std::string& path) {
+    return isStandard<Board>() && tablebase.open(path);
+}
+
+template <class Board>
+bool BasicMancalaAI<Board>::probeTablebase(const Board& board, const Features& features, int& score) const {
+    if (!tablebase.isOpen() || features.sideStones[0] + features.sideStones[1] > tablebase.getMaxStones()) {
+        return false;
+    }
+    
+    int moverMargin;
+    if (!probeEndgame(tablebase, board, moverMargin)) {
+        return false;
+    }
+    
+    // Final result: stones already stored plus what best play still gains
+    int margin = board.getScore(2) - board.getScore(1);
+    margin += board.isPlayer1Turn() ? -moverMargin : moverMargin;
+    
+    if (margin > 0) {  // AI wins
+        score = WIN_SCORE;
+    } else if (margin < 0) {  // Human wins
+        score = -WIN_SCORE;
+    } else {  // Tie
+        score = 0;
+    }
+    return true;
 }
 
-int MancalaAI::evaluateBoard(const MancalaGame& game) {
+template <class Board>
+int BasicMancalaAI<Board>::evaluateBoard(const Board& board) const {
     // Game over condition has highest priority
-    if (game.isGameOver()) {
-        int winner = game.getWinner();
+    if (board.isGameOver()) {
+        int winner = board.getWinner();
         if (winner == 2) {  // AI wins
-            return 10000;
+            return WIN_SCORE;
         } else if (winner == 1) {  // Human wins
-            return -10000;
+            return -WIN_SCORE;
         } else {  // Tie
             return 0;
         }
@@ -157,39 +967,177 @@ int MancalaAI::evaluateBoard(const MancalaGame& game) {
     int score = 0;
     
     // Main factor: Difference in stones in stores (3x weight)
-    score += evaluateStonesDifference(game) * 3;
+    score += evaluateStonesDifference(board) * STORE_WEIGHT;
     
     // Secondary factors
-    score += evaluateExtraTurnPotential(game);
-    score += evaluateCapturePotential(game) * 2;
-    score += evaluateStoneDistribution(game);
+    score += evaluateExtraTurnPotential(board);
+    score += evaluateCapturePotential(board) * CAPTURE_WEIGHT;
+    score += evaluateStoneDistribution(board);
     
     return score;
 }
 
-int MancalaAI::evaluateStonesDifference(const MancalaGame& game) {
+template <class Board>
+bool BasicMancalaAI<Board>::isGameOver(const Features& features) {
+    return features.sideStones[0] == 0 || features.sideStones[1] == 0;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::evaluateFeatures(const Board& board, const Features& features) const {
+    // Game over: the stones left on a side go to that side's store
+    if (isGameOver(features)) {
+        int player1Score = board.pits[Board::PLAYER1_STORE] + features.sideStones[0];
+        int player2Score = board.pits[Board::PLAYER2_STORE] + features.sideStones[1];
+        if (player2Score > player1Score) {  // AI wins
+            return WIN_SCORE;
+        } else if (player1Score > player2Score) {  // Human wins
+            return -WIN_SCORE;
+        } else {  // Tie
+            return 0;
+        }
+    }
+    
+    // Same terms as evaluateBoard; the tactical ones only count for the side to move
+    int side = board.isPlayer1Turn() ? 0 : 1;
+    int sign = board.isPlayer1Turn() ? -1 : 1;
+    
+    int score = (board.pits[Board::PLAYER2_STORE] - board.pits[Board::PLAYER1_STORE]) * STORE_WEIGHT;
+    score += sign * features.extraTurnPits[side] * EXTRA_TURN_BONUS;
+    score += sign * Features::capturePotential(board, side) * CAPTURE_WEIGHT;
+    score += features.sideStones[1] - features.sideStones[0];
+    score += (features.nonEmptyPits[1] - features.nonEmptyPits[0]) * SPREAD_WEIGHT;
+    
+    return score;
+}
+
+template <class Board>
+void BasicMancalaAI<Board>::evaluateBatch(const BasicBoardBatch<Board>& batch, int* scores) const {
+    const size_t BLOCK = BasicBoardBatch<Board>::BLOCK;
+    
+    // Per-side accumulators for one block, index 0 Player 1, 1 Player 2.
+    // Every loop below runs over a whole block, which lets the compiler
+    // vectorize them without remainder handling.
+    int16_t sideStones[2][BLOCK];
+    int16_t nonEmptyPits[2][BLOCK];
+    int16_t extraTurnPits[2][BLOCK];
+    int16_t capture[2][BLOCK];
+    int16_t gain[BLOCK];
+    int32_t blockScores[BLOCK];
+    
+    for (size_t begin = 0; begin < batch.size(); begin += BLOCK) {
+        for (int side = 0; side < 2; side++) {
+            int first = side == 0 ? 0 : Board::PLAYER1_STORE + 1;
+            int store = first + Board::PITS_PER_PLAYER;
+            
+            std::fill(sideStones[side], sideStones[side] + BLOCK, 0);
+            std::fill(nonEmptyPits[side], nonEmptyPits[side] + BLOCK, 0);
+            std::fill(extraTurnPits[side], extraTurnPits[side] + BLOCK, 0);
+            std::fill(capture[side], capture[side] + BLOCK, 0);
+            
+            for (int pit = first; pit < store; pit++) {
+                const uint8_t* stones = batch.pit(pit) + begin;
+                const uint8_t distanceToStore = static_cast<uint8_t>(store - pit);
+                for (size_t b = 0; b < BLOCK; b++) {
+                    sideStones[side][b] += stones[b];
+                    nonEmptyPits[side][b] += stones[b] != 0;
+                    extraTurnPits[side][b] += stones[b] == distanceToStore;
+                }
+            }
+            
+            // Capture potential as in evaluateCapturePotential: an empty own
+            // target pit is worth its opposing stones plus the landing one
+            // for every own pit whose count reaches it exactly
+            for (int target = first; target < store; target++) {
+                const uint8_t* targetStones = batch.pit(target) + begin;
+                const uint8_t* opposingStones = batch.pit(Board::getOpposingPit(target)) + begin;
+                for (size_t b = 0; b < BLOCK; b++) {
+                    bool open = (targetStones[b] == 0) & (opposingStones[b] != 0);
+                    gain[b] = static_cast<int16_t>(open ? opposingStones[b] + 1 : 0);
+                }
+                
+                for (int pit = first; pit < store; pit++) {
+                    if (pit == target) {
+                        continue;
+                    }
+                    const uint8_t* stones = batch.pit(pit) + begin;
+                    const uint8_t distance = static_cast<uint8_t>((target - pit + Board::TOTAL_PITS) % Board::TOTAL_PITS);
+                    for (size_t b = 0; b < BLOCK; b++) {
+                        capture[side][b] += stones[b] == distance ? gain[b] : 0;
+                    }
+                }
+            }
+        }
+        
+        // Combine with the same weights as evaluateFeatures, selecting the
+        // side to move and the game-over score instead of branching
+        const uint8_t* player1Turn = batch.player1Turn() + begin;
+        const uint8_t* store1 = batch.pit(Board::PLAYER1_STORE) + begin;
+        const uint8_t* store2 = batch.pit(Board::PLAYER2_STORE) + begin;
+        
+        for (size_t b = 0; b < BLOCK; b++) {
+            bool turn1 = player1Turn[b] != 0;
+            int sign = turn1 ? -1 : 1;
+            int extraTurns = turn1 ? extraTurnPits[0][b] : extraTurnPits[1][b];
+            int captures = turn1 ? capture[0][b] : capture[1][b];
+            
+            int score = (store2[b] - store1[b]) * STORE_WEIGHT;
+            score += sign * (extraTurns * EXTRA_TURN_BONUS + captures * CAPTURE_WEIGHT);
+            score += sideStones[1][b] - sideStones[0][b];
+            score += (nonEmptyPits[1][b] - nonEmptyPits[0][b]) * SPREAD_WEIGHT;
+            
+            // Game over: the stones left on a side go to that side's store
+            int margin = (store2[b] + sideStones[1][b]) - (store1[b] + sideStones[0][b]);
+            int result = margin > 0 ? WIN_SCORE : margin < 0 ? -WIN_SCORE : 0;
+            bool over = sideStones[0][b] == 0 || sideStones[1][b] == 0;
+            
+            blockScores[b] = over ? result : score;
+        }
+        
+        // The padding boards at the end of the last block are dropped
+        std::copy(blockScores, blockScores + std::min(BLOCK, batch.size() - begin), scores + begin);
+    }
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::evaluateQuiet(const Board& board, const Features& features) const {
+    int score = evaluateFeatures(board, features);
+    if (isGameOver(features)) {
+        return score;
+    }
+    
+    // Take back the mover's tactical terms, quiesce searches those moves
+    int side = board.isPlayer1Turn() ? 0 : 1;
+    int sign = board.isPlayer1Turn() ? -1 : 1;
+    score -= sign * features.extraTurnPits[side] * EXTRA_TURN_BONUS;
+    score -= sign * Features::capturePotential(board, side) * CAPTURE_WEIGHT;
+    return score;
+}
+
+template <class Board>
+int BasicMancalaAI<Board>::evaluateStonesDifference(const Board& board) const {
     // Simple difference between AI's store and human's store
-    return game.getScore(2) - game.getScore(1);
+    return board.getScore(2) - board.getScore(1);
 }
 
-int MancalaAI::evaluateExtraTurnPotential(const MancalaGame& game) {
+template <class Board>
+int BasicMancalaAI<Board>::evaluateExtraTurnPotential(const Board& board) const {
     int score = 0;
-    bool isAITurn = !game.isPlayer1Turn();
+    bool isAITurn = !board.isPlayer1Turn();
     
     // Check each pit on the current player's side
-    int start = isAITurn ? MancalaGame::PLAYER1_STORE + 1 : 0;
-    int end = isAITurn ? MancalaGame::PLAYER2_STORE : MancalaGame::PLAYER1_STORE;
-    int playerStore = isAITurn ? MancalaGame::PLAYER2_STORE : MancalaGame::PLAYER1_STORE;
+    int start = isAITurn ? Board::PLAYER1_STORE + 1 : 0;
+    int end = isAITurn ? Board::PLAYER2_STORE : Board::PLAYER1_STORE;
+    int playerStore = isAITurn ? Board::PLAYER2_STORE : Board::PLAYER1_STORE;
     
     for (int i = start; i < end; i++) {
-        int stones = game.getStonesInPit(i);
+        int stones = board.getStonesInPit(i);
         
         // If the number of stones equals the distance to the store,
         // moving from this pit would result in an extra turn
-        int distanceToStore = (playerStore - i + MancalaGame::TOTAL_PITS) % MancalaGame::TOTAL_PITS;
+        int distanceToStore = (playerStore - i + Board::TOTAL_PITS) % Board::TOTAL_PITS;
         
         if (stones == distanceToStore) {
-            score += 5;  // Potential for extra turn
+            score += EXTRA_TURN_BONUS;  // Potential for extra turn
         }
     }
     
@@ -197,16 +1145,17 @@ int MancalaAI::evaluateExtraTurnPotential(const MancalaGame& game) {
     return isAITurn ? score : -score;
 }
 
-int MancalaAI::evaluateCapturePotential(const MancalaGame& game) {
+template <class Board>
+int BasicMancalaAI<Board>::evaluateCapturePotential(const Board& board) const {
     int score = 0;
-    bool isAITurn = !game.isPlayer1Turn();
+    bool isAITurn = !board.isPlayer1Turn();
     
     // Check each pit on the current player's side
-    int start = isAITurn ? MancalaGame::PLAYER1_STORE + 1 : 0;
-    int end = isAITurn ? MancalaGame::PLAYER2_STORE : MancalaGame::PLAYER1_STORE;
+    int start = isAITurn ? Board::PLAYER1_STORE + 1 : 0;
+    int end = isAITurn ? Board::PLAYER2_STORE : Board::PLAYER1_STORE;
     
     for (int i = start; i < end; i++) {
-        int stones = game.getStonesInPit(i);
+        int stones = board.getStonesInPit(i);
         
         // Empty pits on own side are potential capture targets
         if (stones == 0) {
@@ -214,11 +1163,11 @@ int MancalaAI::evaluateCapturePotential(const MancalaGame& game) {
             for (int j = start; j < end; j++) {
                 if (j == i) continue;
                 
-                int distance = (i - j + MancalaGame::TOTAL_PITS) % MancalaGame::TOTAL_PITS;
-                if (game.getStonesInPit(j) == distance) {
+                int distance = (i - j + Board::TOTAL_PITS) % Board::TOTAL_PITS;
+                if (board.getStonesInPit(j) == distance) {
                     // The opposing pit that would be captured
-                    int opposingPit = (MancalaGame::TOTAL_PITS - 2 - i);
-                    int opposingStones = game.getStonesInPit(opposingPit);
+                    int opposingPit = (Board::TOTAL_PITS - 2 - i);
+                    int opposingStones = board.getStonesInPit(opposingPit);
                     
                     if (opposingStones > 0) {
                         // Higher score for capturing more stones
@@ -233,16 +1182,17 @@ int MancalaAI::evaluateCapturePotential(const MancalaGame& game) {
     return isAITurn ? score : -score;
 }
 
-int MancalaAI::evaluateStoneDistribution(const MancalaGame& game) {
+template <class Board>
+int BasicMancalaAI<Board>::evaluateStoneDistribution(const Board& board) const {
     int score = 0;
-    bool isAITurn = !game.isPlayer1Turn();
+    bool isAITurn = !board.isPlayer1Turn();
     
     // Evaluate AI's side (Player 2)
     int aiTotalStones = 0;
     int aiPitsWithStones = 0;
     
-    for (int i = MancalaGame::PLAYER1_STORE + 1; i < MancalaGame::PLAYER2_STORE; i++) {
-        int stones = game.getStonesInPit(i);
+    for (int i = Board::PLAYER1_STORE + 1; i < Board::PLAYER2_STORE; i++) {
+        int stones = board.getStonesInPit(i);
         aiTotalStones += stones;
         
         if (stones > 0) {
@@ -254,8 +1204,8 @@ int MancalaAI::evaluateStoneDistribution(const MancalaGame& game) {
     int humanTotalStones = 0;
     int humanPitsWithStones = 0;
     
-    for (int i = 0; i < MancalaGame::PLAYER1_STORE; i++) {
-        int stones = game.getStonesInPit(i);
+    for (int i = 0; i < Board::PLAYER1_STORE; i++) {
+        int stones = board.getStonesInPit(i);
         humanTotalStones += stones;
         
         if (stones > 0) {
@@ -270,7 +1220,11 @@ int MancalaAI::evaluateStoneDistribution(const MancalaGame& game) {
     int pitsDiff = aiPitsWithStones - humanPitsWithStones;
     
     // Combine the factors
-    score = stonesDiff + pitsDiff * 2;
+    score = stonesDiff + pitsDiff * SPREAD_WEIGHT;
     
     return score;
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_AI(PITS, STONES) template class BasicMancalaAI<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_AI)
+#undef INSTANTIATE_AI
@@ -1,35 +1,345 @@
 #ifndef AI_H
 #define AI_H
 
-#include "mancala.h"
+#include "board.h"
+#include "boardbatch.h"
+#include "endgame.h"
+#include "engine.h"
+#include "evalfeatures.h"
+#include "moveorder.h"
+#include "openingbook.h"
+#include "searchstats.h"
+#include "transposition.h"
+#include "turngen.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
 #include <vector>
 
-class MancalaAI {
+// Alpha-beta engine for boards of type Board (one of MANCALA_VARIANTS).
+// The endgame tablebase and the opening book only cover the standard
+// board; loading them into another variant returns false.
+template <class Board>
+class BasicMancalaAI : public BasicEngine<Board> {
 public:
     // Constructor with difficulty level (affects search depth)
-    MancalaAI(int difficulty = 2);
+    BasicMancalaAI(int difficulty = 2);
     
-    // Find the best move for the current game state
-    int findBestMove(const MancalaGame& game);
+    // Score of a won game; every heuristic score is well inside this range
+    static const int WIN_SCORE = 10000;
+    
+    // Deepest iteration a time-budgeted search will attempt
+    static const int MAX_SEARCH_DEPTH = 64;
+    
+    // Find the best move for the current game state, searching to the
+    // depth set by the difficulty level
+    int findBestMove(const Board& board) override;
+    
+    // Find the best move within a wall-clock budget. Iterative deepening
+    // returns the move of the last depth that completed before the deadline.
+    int findBestMove(const Board& board, std::chrono::milliseconds budget) override;
+    
+    // Same as above, also returning what the search did
+    int findBestMove(const Board& board, SearchStats& stats);
+    int findBestMove(const Board& board, std::chrono::milliseconds budget, SearchStats& stats);
+    
+    // Statistics of the previous search. Cutoff, hash and tablebase counts
+    // are always collected, the other per-node counters only in builds with
+    // MANCALA_SEARCH_STATS.
+    const SearchStats& getLastSearchStats() const;
+    
+    // Write the statistics of every search to log as one JSON object per
+    // line; nullptr (the default) turns logging off. The stream must
+    // outlive the AI or be reset first.
+    void setStatsLog(std::ostream* log);
+    
+    // Ask a running search (from another thread) to return as soon as
+    // possible. The request sticks: searches started later also return at
+    // once, with the first legal move, until resetStop() is called.
+    void stop() override;
+    void resetStop() override;
+    
+    // Depth of the last completed iteration of the previous search
+    int getLastSearchDepth() const override;
+    
+    // Nodes visited by all threads during the last search
+    uint64_t getLastSearchNodes() const override;
+    
+    // Share of beta cutoffs in the last search that came from the first move
+    // tried
+    double getFirstMoveCutoffRate() const;
     
     // Set the AI difficulty level
-    void setDifficulty(int difficulty);
+    void setDifficulty(int difficulty) override;
+    
+    // Search to a fixed depth instead of the difficulty's (offline tools)
+    void setSearchDepth(int depth);
+    
+    // Memory budget of the transposition table in megabytes; clears it
+    void setHashSize(size_t megabytes);
+    
+    // The transposition table and the history heuristic carry over from one
+    // search to the next, so later moves (and games) start warm. This
+    // forgets both, so the next search starts cold. Not safe while a search
+    // is running.
+    void clearSearchState();
+    
+    // Write the transposition table to a file, or read back one written for
+    // the same variant and hash size. Returns false on failure. Not safe
+    // while a search is running.
+    bool saveHash(const std::string& path) const;
+    bool loadHash(const std::string& path);
+    
+    // Number of threads searching in parallel (Lazy SMP); 1 searches serially
+    void setThreads(int count) override;
+    
+    // Keep searching extra turns and captures past the nominal depth until
+    // the position is quiet (on by default)
+    void setQuiescence(bool enabled);
+    
+    // Selective search, each part on by default and switchable on its own
+    // to measure it in self-play:
+    // - late move reductions: quiet moves ordered late are searched one ply
+    //   shallower with a null window first, and again at full depth only if
+    //   that beats alpha;
+    // - futility pruning: near the leaves, quiet moves are skipped when the
+    //   static score is too far below alpha for one of them to catch up;
+    // - razoring: just above the leaves, a position far below alpha is
+    //   handed to the quiescence search, and only searched fully if that
+    //   gets back above alpha.
+    // None of them applies to principal variation nodes, nor to the search
+    // by whole turns.
+    void setLateMoveReductions(bool enabled);
+    void setFutilityPruning(bool enabled);
+    void setRazoring(bool enabled);
+    
+    // Search by whole turns instead of single sowings: every node expands
+    // the complete turns of the side to move (see TurnGenerator), and depth
+    // counts turns. After an extra turn, findBestMove plays the rest of the
+    // turn it chose without searching again. Off by default; switching
+    // clears the search state. Not safe while a search is running.
+    void setWholeTurns(bool enabled);
+    
+    // Share of transposition table probes that hit during the last search
+    double getHashHitRate() const;
+    
+    // Evaluation function to score a game state from Player 2's point of
+    // view with a full board scan (the search uses evaluateFeatures)
+    int evaluateBoard(const Board& board) const;
+    
+    // evaluateBoard for every board of batch, written to scores[0 .. size).
+    // Runs pit by pit over blocks of boards without per-board branches.
+    void evaluateBatch(const BasicBoardBatch<Board>& batch, int* scores) const;
+    
+    // Memory-map an endgame tablebase written by tbgen. Positions it covers
+    // are scored exactly instead of searched. Returns false if the file is
+    // missing or invalid. Not safe while a search is running.
+    bool loadTablebase(const std::string& path) override;
+    
+    // Positions scored from the endgame tablebase during the last search
+    uint64_t getTablebaseHits() const;
+    
+    // Memory-map an opening book written by bookgen. findBestMove plays
+    // its move without searching whenever the position is in the book and
+    // was searched no deeper than its own depth limit; time-limited
+    // searches always use it.
+    // Returns false if the file is missing or invalid. Not safe while a
+    // search is running.
+    bool loadOpeningBook(const std::string& path) override;
+    
+    // True if the last findBestMove answered from the opening book
+    bool lastMoveFromBook() const;
     
 private:
+    typedef typename Board::Features Features;
+    
+    // Shallowest remaining depth at which the transposition table is used
+    static const int TT_MIN_DEPTH = 2;
+    
+    // Version of the scores in saved tables: bump it whenever the evaluation
+    // (weights, terms) or the score encoding changes, so that files saved by
+    // an older build are rejected instead of replaying stale scores
+    static const uint32_t HASH_SCORE_VERSION = 1;
+    
+    // Tells saved tables of different score versions, variants and search modes apart
+    uint32_t hashFileId() const {
+        return HASH_SCORE_VERSION << 24 | (wholeTurns ? 1u << 16 : 0u) |
+               Board::PITS_PER_PLAYER << 8 | Board::INITIAL_STONES;
+    }
+    
+    // Bound outside every real score, for open search windows
+    static const int INFINITE_SCORE = WIN_SCORE + 1;
+    
+    // Half-width of the first aspiration window around the previous score
+    static const int ASPIRATION_WINDOW = 8;
+    
+    // Late move reductions: from this remaining depth and move index on
+    static const int LMR_MIN_DEPTH = 3;
+    static const int LMR_FIRST_MOVE = 2;
+    
+    // Futility pruning and razoring up to these remaining depths, with a
+    // margin per ply of remaining depth against the full static evaluation
+    // (worth 8 and about 13 stones of store difference)
+    static const int FUTILITY_DEPTH = 2;
+    static const int FUTILITY_MARGIN = 24;
+    static const int RAZOR_DEPTH = 2;
+    static const int RAZOR_MARGIN = 40;
+    
+    // Evaluation weights
+    static const int STORE_WEIGHT = 3;      // Per stone of store difference
+    static const int EXTRA_TURN_BONUS = 5;  // Per pit that can reach the store exactly
+    static const int CAPTURE_WEIGHT = 2;    // Per stone of capture potential
+    static const int SPREAD_WEIGHT = 2;     // Per non-empty pit
+    
+    
+    // The clock is read once every TIME_CHECK_INTERVAL + 1 nodes
+    static const uint64_t TIME_CHECK_INTERVAL = 4095;
+    
+    // The whole turns of one ply of a thread's search and the order to try them in
+    struct TurnList {
+        std::vector<BasicTurn<Board> > turns;
+        std::vector<int> scores;
+        std::vector<int> order;
+    };
+    
+    // Sowings still to play from the turn chosen by the last search, each
+    // with the hash of the position it is played from
+    struct PlannedSowing {
+        uint64_t hash;
+        int pit;
+    };
+    
+    // State owned by one search thread. With Lazy SMP every thread searches
+    // its own copy of the root position and they share only the
+    // transposition table; the main thread's result is the one returned.
+    struct SearchThread {
+        Board board;
+        uint64_t hash;
+        Features features;  // Incrementally maintained inputs of evaluateFeatures
+        BasicMoveOrdering<Board> moveOrdering;
+        BasicTurnGenerator<Board> turnGenerator;
+        std::vector<TurnList> turnLists;  // Indexed by ply, whole-turn search only
+        int iterationTurn;  // Best root turn of the running iteration
+        int bestTurn;       // Best root turn of the last completed iteration, -1 if none
+        bool isMain;  // Only the main thread reads the clock
+        int completedDepth;
+        uint64_t nodes;
+        uint64_t cutoffs;
+        uint64_t firstMoveCutoffs;
+        uint64_t hashProbes;
+        uint64_t hashHits;
+        uint64_t tablebaseHits;
+        uint64_t leaves;
+        uint64_t quiescenceNodes;
+        uint64_t reductions;
+        uint64_t reSearches;
+        uint64_t futilityPrunes;
+        uint64_t razorCuts;
+        int maxPly;
+    };
+    
     int difficulty;
     int maxDepth;  // Calculated from difficulty
+    int threadCount;
+    bool quiescence;
+    bool lateMoveReductions;
+    bool futilityPruning;
+    bool razoring;
+    bool wholeTurns;
+    std::vector<PlannedSowing> plannedTurn;
+    TranspositionTable transpositionTable;
+    EndgameTablebase tablebase;
+    OpeningBook openingBook;
+    SearchStats lastStats;
+    std::ostream* statsLog;
+    std::vector<SearchThread> threads;  // threads[0] is the main thread
+    
+    // Per-search state shared by all threads
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+    std::atomic<bool> stopped;
+    std::atomic<bool> stopRequested;  // Set by stop(), only cleared by resetStop()
+    std::chrono::steady_clock::time_point searchStart;
+    
+    // Run a search with all threads and return the main thread's move,
+    // then gather its statistics
+    int startSearch(const Board& board, int depthLimit);
+    int runSearch(const Board& board, int depthLimit);
+    void collectStats(int move);
+    
+    // Search depth startDepth, startDepth + 1, ... up to depthLimit on one
+    // thread. Returns the best move of the last completed iteration.
+    int iterativeDeepening(SearchThread& thread, int startDepth, int depthLimit);
     
-    // Minimax algorithm with alpha-beta pruning
-    int minimax(MancalaGame* game, int depth, bool isMaximizing, int alpha, int beta, bool& getExtraTurn);
+    // One root iteration with the window (alpha, beta); returns false if it
+    // was aborted. bestMove is searched first and holds the iteration's best
+    // move on return, bestScore its score for the side to move.
+    bool searchRoot(SearchThread& thread, int depth, int alpha, int beta, int& bestMove, int& bestScore);
     
-    // Evaluation function to score a game state
-    int evaluateBoard(const MancalaGame& game);
+    // Count a cutoff and feed it to the thread's killer and history tables
+    void recordCutoff(SearchThread& thread, int move, int moveIndex, int ply, int depth);
+    
+    // True once the search should unwind; sets stopped on a stop request or,
+    // on the main thread, when the deadline has passed
+    bool timeUp(SearchThread& thread);
+    
+    // Principal variation search in negamax form: scores are from the point
+    // of view of the side to move. Moves are made and unmade in place on the
+    // thread's board, with its hash kept in sync for transposition table
+    // lookups. ply counts sowings from the root.
+    int negamax(SearchThread& thread, int depth, int ply, int alpha, int beta);
+    
+    // Score of the move just made for the side that made it: the first move
+    // with the full window, later ones with a null window first
+    int searchMove(SearchThread& thread, int depth, int ply, int alpha, int beta, bool extraTurn, bool firstMove);
+    
+    // negamax of the position after a move, seen from the side that moved
+    int searchChild(SearchThread& thread, int depth, int ply, int alpha, int beta, bool extraTurn);
+    
+    // negamax over whole turns: depth counts turns and ply counts turns
+    // from the root. The table's best move is an index in the turn list.
+    int negamaxTurns(SearchThread& thread, int depth, int ply, int alpha, int beta);
+    bool searchRootTurns(SearchThread& thread, int depth, int alpha, int beta, int& bestMove, int& bestScore);
+    
+    // Generate the turns of the thread's position into list and order them:
+    // the turn at index first (-1 for none), then by static score after it
+    void generateTurns(SearchThread& thread, TurnList& list, int first);
+    
+    // Play the remaining sowings of the chosen turn; return the next one
+    // if board is where the plan continues, otherwise -1 (and drop the plan)
+    int plannedSowing(const Board& board, uint64_t hash);
+    
+    // Quiescence search below the nominal depth: only extra turns and
+    // captures are searched, and the side to move may stand pat on the
+    // static evaluation instead. Same score convention as negamax.
+    int quiesce(SearchThread& thread, int ply, int alpha, int beta);
+    
+    // Score a position from the endgame tablebase as a win, loss or tie;
+    // returns false if the table is not loaded or has too few stones
+    bool probeTablebase(const Board& board, const Features& features, int& score) const;
+    
+    // Same score as evaluateBoard from incrementally maintained features,
+    // without scanning the board; used at the leaves of the search
+    int evaluateFeatures(const Board& board, const Features& features) const;
+    static bool isGameOver(const Features& features);
+    
+    // evaluateFeatures without the side to move's extra-turn and capture
+    // potential; the quiescence search plays those moves out instead
+    int evaluateQuiet(const Board& board, const Features& features) const;
     
     // Helper functions for evaluation
-    int evaluateStonesDifference(const MancalaGame& game);
-    int evaluateExtraTurnPotential(const MancalaGame& game);
-    int evaluateCapturePotential(const MancalaGame& game);
-    int evaluateStoneDistribution(const MancalaGame& game);
+    int evaluateStonesDifference(const Board& board) const;
+    int evaluateExtraTurnPotential(const Board& board) const;
+    int evaluateCapturePotential(const Board& board) const;
+    int evaluateStoneDistribution(const Board& board) const;
 };
 
+template <class Board> const int BasicMancalaAI<Board>::WIN_SCORE;
+template <class Board> const int BasicMancalaAI<Board>::MAX_SEARCH_DEPTH;
+
+typedef BasicMancalaAI<MancalaBoard> MancalaAI;
+
 #endif // AI_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "aiworker.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    template <class Board>
+    bool samePosition(const Board& a, const Board& b) {
+        return a.player1Turn == b.player1Turn && std::equal(a.pits, a.pits + Board::TOTAL_PITS, b.pits);
+    }
+    
+    // Reply not searched yet
+    const int NO_REPLY = -2;
+}
+
+template <class Board>
+BasicAIWorker<Board>::BasicAIWorker(Engine& ai) : ai(&ai) {
+}
+
+template <class Board>
+BasicAIWorker<Board>::~BasicAIWorker() {
+    cancel();
+}
+
+template <class Board>
+void BasicAIWorker<Board>::start(const Board& board) {
+    if (result.valid()) {
+        ai->stop();
+        result.wait();
+        result = std::future<int>();
+    }
+    
+    if (takePonderResult(board)) {
+        return;
+    }
+    stopPondering();
+    
+    // No search is running now, so the stop request of a cancelled one can be dropped
+    ai->resetStop();
+    
+    // The board is copied into the task, the caller may change its own freely
+    Engine& engine = *ai;
+    result = std::async(std::launch::async, [&engine, board]() {
+        return engine.findBestMove(board);
+    });
+}
+
+template <class Board>
+bool BasicAIWorker<Board>::isBusy() const {
+    return result.valid();
+}
+
+template <class Board>
+bool BasicAIWorker<Board>::isReady() const {
+    return result.valid() && result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+template <class Board>
+int BasicAIWorker<Board>::takeMove() {
+    int move = result.get();
+    
+    // A search handed over by the pondering thread ends it
+    stopPondering();
+    return move;
+}
+
+template <class Board>
+void BasicAIWorker<Board>::ponder(const Board& board) {
+    if (result.valid()) {
+        return;
+    }
+    if (ponderState && samePosition(ponderState->root, board)) {
+        return;
+    }
+    stopPondering();
+    
+    std::shared_ptr<PonderState> state = std::make_shared<PonderState>();
+    state->root = board;
+    
+    // Only moves that hand the turn over need a reply; after an extra turn
+    // the human is pondered on again
+    int moves[Board::PITS_PER_PLAYER];
+    int moveCount = board.getPossibleMoves(moves);
+    for (int i = 0; i < moveCount; i++) {
+        Board next = board;
+        next.makeMove(moves[i]);
+        if (!next.isGameOver() && next.isPlayer1Turn() != board.isPlayer1Turn()) {
+            state->positions.push_back(next);
+        }
+    }
+    state->replies.assign(state->positions.size(), NO_REPLY);
+    
+    ai->resetStop();
+    ponderState = state;
+    Engine& engine = *ai;
+    ponderTask = std::async(std::launch::async, [&engine, state]() {
+        ponderPositions(engine, *state);
+    });
+}
+
+template <class Board>
+void BasicAIWorker<Board>::ponderPositions(Engine& engine, PonderState& state) {
+    for (size_t i = 0; i < state.positions.size(); i++) {
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (state.stopping) {
+                return;
+            }
+            state.current = i;
+        }
+        
+        int move = engine.findBestMove(state.positions[i]);
+        
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.awaited) {
+            state.reply.set_value(move);
+            return;
+        }
+        if (state.stopping) {
+            return;  // Interrupted, the move may come from a partial search
+        }
+        state.replies[i] = move;
+    }
+}
+
+template <class Board>
+bool BasicAIWorker<Board>::takePonderResult(const Board& board) {
+    if (!ponderState) {
+        return false;
+    }
+    PonderState& state = *ponderState;
+    bool found = false;
+    
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.stopping) {
+            return false;
+        }
+        
+        for (size_t i = 0; i < state.positions.size(); i++) {
+            if (!samePosition(state.positions[i], board)) {
+                continue;
+            }
+            
+            if (state.replies[i] != NO_REPLY) {
+                // Searched already: the move is ready now
+                std::promise<int> ready;
+                ready.set_value(state.replies[i]);
+                result = ready.get_future();
+                found = true;
+                break;
+            }
+            
+            if (i == state.current) {
+                // Being searched: let it finish and end pondering there
+                state.awaited = true;
+                result = state.reply.get_future();
+                return true;
+            }
+            break;
+        }
+    }
+    
+    // The other replies are not needed any more
+    if (found) {
+        stopPondering();
+    }
+    return found;
+}
+
+template <class Board>
+void BasicAIWorker<Board>::stopPondering() {
+    if (!ponderTask.valid()) {
+        ponderState.reset();
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(ponderState->mutex);
+        ponderState->stopping = true;
+        
+        // An awaited search is the move being played, let it complete
+        if (!ponderState->awaited) {
+            ai->stop();
+        }
+    }
+    ponderTask.wait();
+    ponderTask = std::future<void>();
+    ponderState.reset();
+}
+
+template <class Board>
+void BasicAIWorker<Board>::cancel() {
+    if (result.valid()) {
+        ai->stop();
+        result.wait();
+        result = std::future<int>();
+    }
+    stopPondering();
+}
+
+template <class Board>
+void BasicAIWorker<Board>::setEngine(Engine& engine) {
+    cancel();
+    ai = &engine;
+}
+
+#define INSTANTIATE_WORKER(PITS, STONES) template class BasicAIWorker<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_WORKER)
+#undef INSTANTIATE_WORKER
@@ -0,0 +1,88 @@
+#ifndef AIWORKER_H
+#define AIWORKER_H
+
+#include "board.h"
+#include "engine.h"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Runs engine searches on a background thread so the caller (the GUI
+// event loop) never blocks. One search at a time; the engine must not be
+// used directly while a search is running.
+//
+// While the human is thinking, ponder() searches the engine's reply to each
+// of the human's moves in advance. When the human moves into one of them,
+// start() returns the precomputed reply at once, or keeps the pondering
+// search of that position running instead of starting over.
+//
+// Board is the variant played, as for BasicEngine.
+template <class Board>
+class BasicAIWorker {
+public:
+    typedef BasicEngine<Board> Engine;
+    
+    explicit BasicAIWorker(Engine& ai);
+    
+    // Cancels any running search
+    ~BasicAIWorker();
+    
+    // Start searching the given position in the background
+    void start(const Board& board);
+    
+    // Whether a search was started and its move has not been taken yet
+    bool isBusy() const;
+    
+    // Whether the started search has finished
+    bool isReady() const;
+    
+    // Move found by the finished search (-1 if there was none). Only valid when isReady().
+    int takeMove();
+    
+    // Start pondering a position where the human is to move. Does nothing if
+    // that position is already being pondered; a different one replaces it.
+    // Ignored while a search started with start() has not been taken.
+    void ponder(const Board& board);
+    
+    // Stop the running search and any pondering and wait for their thread;
+    // the results are discarded
+    void cancel();
+    
+    // Search with another engine from the next start() on; cancels any running search
+    void setEngine(Engine& engine);
+    
+private:
+    // Shared between the pondering thread and the caller
+    struct PonderState {
+        Board root;                           // Human to move
+        std::vector<Board> positions;         // Engine to move after each human move
+        std::vector<int> replies;             // Move for each position, -2 until searched
+        
+        std::mutex mutex;                     // Guards the members below and replies
+        size_t current = 0;                   // Position being searched
+        bool stopping = false;                // Leave after the current search
+        bool awaited = false;                 // start() is waiting for the current search
+        std::promise<int> reply;              // Its result once finished
+    };
+    
+    // Pondering thread: search every position in turn until stopped
+    static void ponderPositions(Engine& engine, PonderState& state);
+    
+    // Hand the pondering over to start(board) if it has or is computing that
+    // position's reply; returns false if start() must search itself
+    bool takePonderResult(const Board& board);
+    
+    // Stop pondering and wait for its thread
+    void stopPondering();
+    
+    Engine* ai;
+    std::future<int> result;
+    std::shared_ptr<PonderState> ponderState;
+    std::future<void> ponderTask;
+};
+
+// The standard game: six pits per side, four stones each
+typedef BasicAIWorker<MancalaBoard> AIWorker;
+
+#endif // AIWORKER_H
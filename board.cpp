@@ -0,0 +1,404 @@
+#include "board.h"
+#include "evalfeatures.h"
+#include "zobrist.h"
+#ifdef MANCALA_SWAR_BOARD
+#include "packedboard.h"
+#endif
+
+template <int Pits, int Stones>
+void BasicMancala<Pits, Stones>::reset() {
+    // Initialize the board with INITIAL_STONES stones in each small pit
+    for (int i = 0; i < TOTAL_PITS; i++) {
+        if (i == PLAYER1_STORE || i == PLAYER2_STORE) {
+            pits[i] = 0;  // Stores start empty
+        } else {
+            pits[i] = INITIAL_STONES;
+        }
+    }
+    
+    // Player 1 starts
+    player1Turn = true;
+}
+
+template <int Pits, int Stones>
+bool BasicMancala<Pits, Stones>::isGameOver() const {
+#ifdef MANCALA_SWAR_BOARD
+    // Both side-emptiness tests are masks over the packed lanes
+    return PackedBoard::sideEmpty<BasicMancala>(PackedBoard::load<BasicMancala>(pits));
+#else
+    // Check if all pits on one side are empty
+    bool player1SideEmpty = true;
+    bool player2SideEmpty = true;
+    
+    for (int i = 0; i < PITS_PER_PLAYER; i++) {
+        if (pits[i] > 0) {
+            player1SideEmpty = false;
+        }
+        if (pits[i + PLAYER1_STORE + 1] > 0) {
+            player2SideEmpty = false;
+        }
+    }
+    
+    return player1SideEmpty || player2SideEmpty;
+#endif
+}
+
+template <int Pits, int Stones>
+int BasicMancala<Pits, Stones>::getWinner() const {
+    if (!isGameOver()) {
+        return 0;  // Game not over yet
+    }
+    
+    // Count stones in each player's store
+    int player1Score = pits[PLAYER1_STORE];
+    int player2Score = pits[PLAYER2_STORE];
+    
+    // Include stones remaining on the board in the final score
+#ifdef MANCALA_SWAR_BOARD
+    PackedBoard::Lanes lanes = PackedBoard::load<BasicMancala>(pits);
+    player1Score += PackedBoard::player1SideStones<BasicMancala>(lanes);
+    player2Score += PackedBoard::player2SideStones<BasicMancala>(lanes);
+#else
+    for (int i = 0; i < PITS_PER_PLAYER; i++) {
+        player1Score += pits[i];
+        player2Score += pits[i + PLAYER1_STORE + 1];
+    }
+#endif
+    
+    if (player1Score > player2Score) {
+        return 1;  // Player 1 wins
+    } else if (player2Score > player1Score) {
+        return 2;  // Player 2 wins
+    } else {
+        return 0;  // Tie
+    }
+}
+
+template <int Pits, int Stones>
+int BasicMancala<Pits, Stones>::getScore(int player) const {
+    if (player == 1) {
+        return pits[PLAYER1_STORE];
+    } else {
+        return pits[PLAYER2_STORE];
+    }
+}
+
+template <int Pits, int Stones>
+bool BasicMancala<Pits, Stones>::isValidMove(int pit) const {
+    // Check if the pit exists and belongs to the current player
+    if (pit < 0 || pit >= TOTAL_PITS || pit == PLAYER1_STORE || pit == PLAYER2_STORE) {
+        return false;
+    }
+    
+    // Check if the pit belongs to the current player
+    if (player1Turn && pit >= PLAYER1_STORE) {
+        return false;
+    }
+    if (!player1Turn && pit < PLAYER1_STORE) {
+        return false;
+    }
+    
+    // Check if the pit has stones
+    return pits[pit] > 0;
+}
+
+template <int Pits, int Stones>
+bool BasicMancala<Pits, Stones>::makeMove(int pit) {
+    if (!isValidMove(pit)) {
+        return false;
+    }
+    
+    Undo undo;
+    makeMove(pit, undo);
+    return true;
+}
+
+namespace {
+    // Trackers let the one makeMove implementation keep extra per-position
+    // state in sync. Every pit change goes through setPit, except that the
+    // packed board writes the sown pits directly when PER_PIT is false.
+    struct BoardOnly {
+        static const bool PER_PIT = false;
+        
+        void setPit(uint8_t* pits, int pit, int stones) {
+            pits[pit] = static_cast<uint8_t>(stones);
+        }
+        void flipTurn() {}
+        template <class Board>
+        void recompute(const Board&) {}
+    };
+    
+    struct HashTracker {
+        static const bool PER_PIT = true;
+        uint64_t& hash;
+        
+        void setPit(uint8_t* pits, int pit, int stones) {
+            hash ^= Zobrist::pitKey(pit, pits[pit]) ^ Zobrist::pitKey(pit, stones);
+            pits[pit] = static_cast<uint8_t>(stones);
+        }
+        void flipTurn() {
+            hash ^= Zobrist::sideKey();
+        }
+        template <class Board>
+        void recompute(const Board& board) {
+            hash = Zobrist::hash(board);
+        }
+    };
+    
+    template <class Board>
+    struct HashAndFeatureTracker {
+        static const bool PER_PIT = true;
+        uint64_t& hash;
+        typename Board::Features& features;
+        
+        void setPit(uint8_t* pits, int pit, int stones) {
+            hash ^= Zobrist::pitKey(pit, pits[pit]) ^ Zobrist::pitKey(pit, stones);
+            features.setPit(pits, pit, stones);
+        }
+        void flipTurn() {
+            hash ^= Zobrist::sideKey();
+        }
+        void recompute(const Board& board) {
+            hash = Zobrist::hash(board);
+            features = Board::Features::compute(board);
+        }
+    };
+    
+#ifdef MANCALA_SWAR_BOARD
+    // Sow the stones picked up from pit (already emptied) with one add of the
+    // precomputed lane mask. Returns the pit the last stone landed in.
+    template <class Board, typename Tracker>
+    int sowStones(Board& board, int pit, int stones, Tracker& tracker) {
+        typedef PackedBoard::Tables<Board> Tables;
+        const Tables& tables = Tables::instance;
+        PackedBoard::Lanes sown = PackedBoard::add(PackedBoard::load<Board>(board.pits), tables.sow[pit][stones]);
+        
+        if (!Tracker::PER_PIT) {
+            PackedBoard::store<Board>(sown, board.pits);
+        } else {
+            uint8_t after[Board::TOTAL_PITS];
+            PackedBoard::store<Board>(sown, after);
+            int lapPits = Tables::LAP_PITS;
+            int reached = stones < lapPits ? stones : lapPits;
+            for (int i = 0; i < reached; i++) {
+                int target = tables.path[pit][i];
+                tracker.setPit(board.pits, target, after[target]);
+            }
+        }
+        
+        return tables.lastPit[pit][stones];
+    }
+#else
+    // Sow the stones picked up from pit (already emptied) one pit at a time.
+    // Returns the pit the last stone landed in.
+    template <class Board, typename Tracker>
+    int sowStones(Board& board, int pit, int stones, Tracker& tracker) {
+        uint8_t* pits = board.pits;
+        
+        // The mover's successor table already skips the opponent's store
+        const int8_t* next = Board::tables.next[board.player1Turn ? 0 : 1];
+        int currentPit = pit;
+        
+        while (stones > 0) {
+            // Move to the next pit and drop a stone
+            currentPit = next[currentPit];
+            tracker.setPit(pits, currentPit, pits[currentPit] + 1);
+            stones--;
+        }
+        
+        return currentPit;
+    }
+#endif
+    
+    // Shared implementation of the in-place makeMove
+    template <class Board, typename Tracker>
+    void applyMove(Board& board, int pit, typename Board::Undo& undo, Tracker tracker) {
+        uint8_t* pits = board.pits;
+        
+        // Pick up all stones from the selected pit
+        int stones = pits[pit];
+        tracker.setPit(pits, pit, 0);
+        
+        undo.pit = static_cast<int8_t>(pit);
+        undo.stones = static_cast<uint8_t>(stones);
+        undo.capturePit = -1;
+        undo.capturedStones = 0;
+        undo.turnFlipped = false;
+        undo.swept = false;
+        
+        // Distribute stones
+        int currentPit = sowStones(board, pit, stones, tracker);
+        
+        // Check for capture
+        if (pits[currentPit] == 1 && board.isOwnPit(currentPit) &&
+            currentPit != Board::PLAYER1_STORE && currentPit != Board::PLAYER2_STORE) {
+            int opposingPit = Board::getOpposingPit(currentPit);
+            if (pits[opposingPit] > 0) {
+                // Capture the stones
+                int playerStore = board.player1Turn ? Board::PLAYER1_STORE : Board::PLAYER2_STORE;
+                undo.capturePit = static_cast<int8_t>(opposingPit);
+                undo.capturedStones = pits[opposingPit];
+                tracker.setPit(pits, playerStore, pits[playerStore] + pits[opposingPit] + 1);  // Opposing stones + the last stone placed
+                tracker.setPit(pits, opposingPit, 0);
+                tracker.setPit(pits, currentPit, 0);
+            }
+        }
+        
+        // Check if the game is over
+        if (board.isGameOver()) {
+            undo.swept = true;
+            for (int i = 0; i < Board::TOTAL_PITS; i++) {
+                undo.sweptPits[i] = pits[i];
+            }
+            board.collectRemainingStones();
+            tracker.recompute(board);
+            return;
+        }
+        
+        // Extra turn if last stone lands in player's store
+        if ((board.player1Turn && currentPit == Board::PLAYER1_STORE) ||
+            (!board.player1Turn && currentPit == Board::PLAYER2_STORE)) {
+            return;  // Player gets another turn
+        }
+        
+        // Switch turns
+        board.player1Turn = !board.player1Turn;
+        undo.turnFlipped = true;
+        tracker.flipTurn();
+    }
+}
+
+template <int Pits, int Stones>
+void BasicMancala<Pits, Stones>::makeMove(int pit, Undo& undo) {
+    applyMove(*this, pit, undo, BoardOnly());
+}
+
+template <int Pits, int Stones>
+void BasicMancala<Pits, Stones>::makeMove(int pit, Undo& undo, uint64_t& hash) {
+    undo.hash = hash;
+    applyMove(*this, pit, undo, HashTracker{hash});
+}
+
+template <int Pits, int Stones>
+void BasicMancala<Pits, Stones>::makeMove(int pit, Undo& undo, uint64_t& hash, Features& features) {
+    undo.hash = hash;
+    applyMove(*this, pit, undo, HashAndFeatureTracker<BasicMancala>{hash, features});
+}
+
+template <int Pits, int Stones>
+void BasicMancala<Pits, Stones>::unmakeMove(const Undo& undo) {
+    // Undo in the reverse order of makeMove
+    if (undo.turnFlipped) {
+        player1Turn = !player1Turn;
+    }
+    
+    if (undo.swept) {
+        for (int i = 0; i < TOTAL_PITS; i++) {
+            pits[i] = undo.sweptPits[i];
+        }
+    }
+    
+    // The landing pit is the one opposite the captured pit
+    if (undo.capturePit >= 0) {
+        int landingPit = getOpposingPit(undo.capturePit);
+        int playerStore = player1Turn ? PLAYER1_STORE : PLAYER2_STORE;
+        pits[playerStore] -= undo.capturedStones + 1;
+        pits[undo.capturePit] = undo.capturedStones;
+        pits[landingPit] = 1;
+    }
+    
+    // Take the sown stones back along the same path
+#ifdef MANCALA_SWAR_BOARD
+    const PackedBoard::Lanes& sown = PackedBoard::Tables<BasicMancala>::instance.sow[undo.pit][undo.stones];
+    PackedBoard::store<BasicMancala>(PackedBoard::subtract(PackedBoard::load<BasicMancala>(pits), sown), pits);
+#else
+    const int8_t* next = tables.next[player1Turn ? 0 : 1];
+    int stones = undo.stones;
+    int currentPit = undo.pit;
+    while (stones > 0) {
+        currentPit = next[currentPit];
+        pits[currentPit]--;
+        stones--;
+    }
+#endif
+    
+    pits[undo.pit] = undo.stones;
+}
+
+template <int Pits, int Stones>
+void BasicMancala<Pits, Stones>::unmakeMove(const Undo& undo, uint64_t& hash) {
+    unmakeMove(undo);
+    hash = undo.hash;
+}
+
+template <int Pits, int Stones>
+int BasicMancala<Pits, Stones>::getStonesInPit(int pit) const {
+    if (pit >= 0 && pit < TOTAL_PITS) {
+        return pits[pit];
+    }
+    return 0;
+}
+
+template <int Pits, int Stones>
+std::vector<int> BasicMancala<Pits, Stones>::getPossibleMoves() const {
+    int moves[PITS_PER_PLAYER];
+    int count = getPossibleMoves(moves);
+    return std::vector<int>(moves, moves + count);
+}
+
+template <int Pits, int Stones>
+int BasicMancala<Pits, Stones>::getPossibleMoves(int moves[PITS_PER_PLAYER]) const {
+    int count = 0;
+    
+    int start = player1Turn ? 0 : PLAYER1_STORE + 1;
+    int end = player1Turn ? PLAYER1_STORE : TOTAL_PITS - 1;
+    
+    for (int i = start; i < end; i++) {
+        if (pits[i] > 0) {
+            moves[count++] = i;
+        }
+    }
+    
+    return count;
+}
+
+template <int Pits, int Stones>
+bool BasicMancala<Pits, Stones>::isOwnPit(int pit) const {
+    if (player1Turn) {
+        return pit < PLAYER1_STORE;
+    } else {
+        return pit > PLAYER1_STORE && pit < PLAYER2_STORE;
+    }
+}
+
+template <int Pits, int Stones>
+void BasicMancala<Pits, Stones>::collectRemainingStones() {
+#ifdef MANCALA_SWAR_BOARD
+    // Sum each side with one multiply, then clear the small pits by mask
+    typedef PackedBoard::Masks<BasicMancala> Masks;
+    PackedBoard::Lanes lanes = PackedBoard::load<BasicMancala>(pits);
+    int player1Stones = PackedBoard::player1SideStones<BasicMancala>(lanes);
+    int player2Stones = PackedBoard::player2SideStones<BasicMancala>(lanes);
+    lanes.lo &= ~(Masks::PLAYER1_PITS_LO | Masks::PLAYER2_PITS_LO);
+    lanes.hi &= ~(Masks::PLAYER1_PITS_HI | Masks::PLAYER2_PITS_HI);
+    PackedBoard::store<BasicMancala>(lanes, pits);
+    pits[PLAYER1_STORE] += player1Stones;
+    pits[PLAYER2_STORE] += player2Stones;
+#else
+    // Collect all stones from Player 1's side
+    for (int i = 0; i < PITS_PER_PLAYER; i++) {
+        pits[PLAYER1_STORE] += pits[i];
+        pits[i] = 0;
+    }
+    
+    // Collect all stones from Player 2's side
+    for (int i = PLAYER1_STORE + 1; i < PLAYER2_STORE; i++) {
+        pits[PLAYER2_STORE] += pits[i];
+        pits[i] = 0;
+    }
+#endif
+}
+
+#define INSTANTIATE_BOARD(PITS, STONES) template struct BasicMancala<PITS, STONES>;
+MANCALA_VARIANTS(INSTANTIATE_BOARD)
+#undef INSTANTIATE_BOARD
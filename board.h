@@ -0,0 +1,130 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Board variants the game is built for, as (pits per player, initial
+// stones per pit): standard Kalah(6,4) first, then Kalah(4,3), (6,3),
+// (6,5) and (6,6). Every .cpp file with templated definitions
+// instantiates them for each variant in this list.
+#define MANCALA_VARIANTS(X) X(6, 4) X(4, 3) X(6, 3) X(6, 5) X(6, 6)
+
+template <class Board> struct BasicEvalFeatures;
+
+// Everything unmakeMove needs to restore the position before a makeMove.
+template <int Pits>
+struct BasicMoveUndo {
+    uint64_t hash;              // Zobrist hash before the move (hashing variant only)
+    int8_t pit;                 // Pit the stones were picked up from
+    uint8_t stones;             // Number of stones sown
+    int8_t capturePit;          // Opposing pit emptied by a capture, -1 if none
+    uint8_t capturedStones;     // Stones taken from capturePit (the landing stone is extra)
+    bool turnFlipped;           // Side to move changed after the move
+    bool swept;                 // collectRemainingStones ran at the end of the game
+    uint8_t sweptPits[2 * Pits + 2];  // Pit counts before the sweep (valid when swept)
+};
+
+// Per-variant lookup tables, computed at compile time
+template <int Pits>
+struct BasicMancalaTables {
+    static const int TOTAL_PITS = 2 * Pits + 2;
+
+    int8_t side[TOTAL_PITS];        // 0 Player 1's pits, 1 Player 2's pits, -1 stores
+    int8_t opposing[TOTAL_PITS];    // Pit across the board, -1 for stores
+    int8_t next[2][TOTAL_PITS];     // Next pit sown by Player 1 / Player 2, skipping the other store
+
+    constexpr BasicMancalaTables() : side(), opposing(), next() {
+        for (int pit = 0; pit < TOTAL_PITS; pit++) {
+            bool store = pit == Pits || pit == TOTAL_PITS - 1;
+            side[pit] = static_cast<int8_t>(store ? -1 : pit < Pits ? 0 : 1);
+            opposing[pit] = static_cast<int8_t>(store ? -1 : TOTAL_PITS - 2 - pit);
+
+            int following = (pit + 1) % TOTAL_PITS;
+            next[0][pit] = static_cast<int8_t>(following == TOTAL_PITS - 1 ? 0 : following);
+            next[1][pit] = static_cast<int8_t>(following == Pits ? Pits + 1 : following);
+        }
+    }
+};
+
+// Headless board state and rules engine for Kalah with Pits pits per side
+// and Stones stones per pit at the start. It holds no SFML objects and is
+// trivially copyable, so the AI can copy it by value at every search node.
+// The pit count is a compile-time constant, so every loop over the pits has
+// a fixed trip count; withVariant (variant.h) picks an instantiation at runtime.
+template <int Pits, int Stones>
+struct BasicMancala {
+    // Constants for the board
+    static const int PLAYER1_STORE = Pits;
+    static const int PLAYER2_STORE = 2 * Pits + 1;
+    static const int TOTAL_PITS = 2 * Pits + 2;
+    static const int PITS_PER_PLAYER = Pits;
+    static const int INITIAL_STONES = Stones;
+    static const int TOTAL_STONES = 2 * PITS_PER_PLAYER * INITIAL_STONES;
+
+    typedef BasicMoveUndo<Pits> Undo;
+    typedef BasicEvalFeatures<BasicMancala> Features;
+
+    static constexpr BasicMancalaTables<Pits> tables = BasicMancalaTables<Pits>();
+
+    // Stone counts for every pit and store (indices as in MancalaGame)
+    uint8_t pits[TOTAL_PITS];
+    bool player1Turn;
+
+    // Reset to the starting position (Stones stones per pit, Player 1 to move)
+    void reset();
+
+    // Game state methods
+    bool isPlayer1Turn() const { return player1Turn; }
+    bool isGameOver() const;
+    int getWinner() const; // 0 = tie, 1 = player1, 2 = player2
+    int getScore(int player) const; // player 1 or 2
+
+    // Move validation and execution
+    bool isValidMove(int pit) const;
+    bool makeMove(int pit);
+
+    // In-place variant for the search: pit must be a valid move. Fills undo so
+    // that unmakeMove(undo) restores the exact previous position.
+    void makeMove(int pit, Undo& undo);
+    void unmakeMove(const Undo& undo);
+
+    // Same as above, also updating the position's Zobrist hash as stones are sown
+    void makeMove(int pit, Undo& undo, uint64_t& hash);
+    void unmakeMove(const Undo& undo, uint64_t& hash);
+
+    // Also keeps the AI's evaluation features in sync. unmakeMove does not
+    // restore them; the search keeps a copy from before the move instead.
+    void makeMove(int pit, Undo& undo, uint64_t& hash, Features& features);
+
+    // Board state access
+    int getStonesInPit(int pit) const;
+    std::vector<int> getPossibleMoves() const;
+
+    // Allocation-free variant for the search: fills moves and returns the count
+    int getPossibleMoves(int moves[PITS_PER_PLAYER]) const;
+
+    // Helper methods for game logic
+    static int getOpposingPit(int pit) { return tables.opposing[pit]; }
+    bool isOwnPit(int pit) const;
+    void collectRemainingStones();
+};
+
+template <int Pits, int Stones> const int BasicMancala<Pits, Stones>::PLAYER1_STORE;
+template <int Pits, int Stones> const int BasicMancala<Pits, Stones>::PLAYER2_STORE;
+template <int Pits, int Stones> const int BasicMancala<Pits, Stones>::TOTAL_PITS;
+template <int Pits, int Stones> const int BasicMancala<Pits, Stones>::PITS_PER_PLAYER;
+template <int Pits, int Stones> const int BasicMancala<Pits, Stones>::INITIAL_STONES;
+template <int Pits, int Stones> const int BasicMancala<Pits, Stones>::TOTAL_STONES;
+template <int Pits, int Stones> constexpr BasicMancalaTables<Pits> BasicMancala<Pits, Stones>::tables;
+
+// The standard game: six pits per side, four stones each
+typedef BasicMancala<6, 4> MancalaBoard;
+typedef MancalaBoard::Undo MoveUndo;
+
+static_assert(std::is_trivially_copyable<MancalaBoard>::value, "MancalaBoard must be trivially copyable");
+static_assert(sizeof(MoveUndo::sweptPits) == MancalaBoard::TOTAL_PITS, "MoveUndo must cover every pit");
+static_assert(sizeof(MancalaBoard) < 16, "MancalaBoard must stay under 16 bytes");
+
+#endif // BOARD_H
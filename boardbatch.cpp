@@ -0,0 +1,50 @@
+#include "boardbatch.h"
+
+template <class Board>
+void BasicBoardBatch<Board>::clear() {
+    for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+        pits[pit].clear();
+    }
+    turns.clear();
+    count = 0;
+}
+
+template <class Board>
+void BasicBoardBatch<Board>::reserve(size_t boards) {
+    size_t padded = (boards + BLOCK - 1) / BLOCK * BLOCK;
+    for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+        pits[pit].reserve(padded);
+    }
+    turns.reserve(padded);
+}
+
+template <class Board>
+void BasicBoardBatch<Board>::add(const Board& board) {
+    // Start a new block of empty boards when the last one is full
+    if (count == turns.size()) {
+        for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+            pits[pit].resize(count + BLOCK, 0);
+        }
+        turns.resize(count + BLOCK, 0);
+    }
+    
+    for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+        pits[pit][count] = board.pits[pit];
+    }
+    turns[count] = board.player1Turn ? 1 : 0;
+    count++;
+}
+
+template <class Board>
+Board BasicBoardBatch<Board>::get(size_t index) const {
+    Board board;
+    for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+        board.pits[pit] = pits[pit][index];
+    }
+    board.player1Turn = turns[index] != 0;
+    return board;
+}
+
+#define INSTANTIATE_BATCH(PITS, STONES) template class BasicBoardBatch<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_BATCH)
+#undef INSTANTIATE_BATCH
@@ -0,0 +1,49 @@
+#ifndef BOARDBATCH_H
+#define BOARDBATCH_H
+
+#include "board.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Many boards stored structure-of-arrays: the counts of pit i of every
+// board are contiguous, so batch kernels can walk one pit at a time over
+// all boards with plain loops the compiler vectorizes.
+template <class Board>
+class BasicBoardBatch {
+public:
+    // Storage is padded with empty boards to a multiple of BLOCK, so kernels
+    // can always process whole blocks with a fixed trip count
+    static const size_t BLOCK = 256;
+    
+    BasicBoardBatch() : count(0) {}
+    
+    void clear();
+    void reserve(size_t count);
+    void add(const Board& board);
+    
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    
+    // Boards including the padding, a multiple of BLOCK
+    size_t paddedSize() const { return turns.size(); }
+    
+    // Copy board index back out of the batch
+    Board get(size_t index) const;
+    
+    // Counts of one pit for all boards, and 1 for every board with Player 1
+    // to move, each valid for paddedSize() entries
+    const uint8_t* pit(int pit) const { return pits[pit].data(); }
+    const uint8_t* player1Turn() const { return turns.data(); }
+    
+private:
+    std::vector<uint8_t> pits[Board::TOTAL_PITS];
+    std::vector<uint8_t> turns;
+    size_t count;
+};
+
+template <class Board> const size_t BasicBoardBatch<Board>::BLOCK;
+
+typedef BasicBoardBatch<MancalaBoard> BoardBatch;
+
+#endif // BOARDBATCH_H
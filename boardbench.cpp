@@ -0,0 +1,77 @@
+// Nodes-per-second benchmark of the board rules engine. Build it once with
+// the scalar board and once with MANCALA_SWAR_BOARD (CMake builds both as
+// board_bench and board_bench_swar) and compare the reported rates.
+//
+// Usage: board_bench [depth]
+
+#include "board.h"
+#include "zobrist.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    // Walk every move sequence to the given depth with make/unmake
+    uint64_t perft(MancalaBoard& board, int depth) {
+        if (depth == 0 || board.isGameOver()) {
+            return 1;
+        }
+        
+        int moves[MancalaBoard::PITS_PER_PLAYER];
+        int moveCount = board.getPossibleMoves(moves);
+        uint64_t nodes = 0;
+        for (int i = 0; i < moveCount; i++) {
+            MoveUndo undo;
+            board.makeMove(moves[i], undo);
+            nodes += perft(board, depth - 1);
+            board.unmakeMove(undo);
+        }
+        return nodes;
+    }
+    
+    // Same walk with the Zobrist hash updated as the search does
+    uint64_t perftHashed(MancalaBoard& board, uint64_t& hash, int depth) {
+        if (depth == 0 || board.isGameOver()) {
+            return 1;
+        }
+        
+        int moves[MancalaBoard::PITS_PER_PLAYER];
+        int moveCount = board.getPossibleMoves(moves);
+        uint64_t nodes = 0;
+        for (int i = 0; i < moveCount; i++) {
+            MoveUndo undo;
+            board.makeMove(moves[i], undo, hash);
+            nodes += perftHashed(board, hash, depth - 1);
+            board.unmakeMove(undo, hash);
+        }
+        return nodes;
+    }
+    
+    template <typename Walk>
+    void report(const char* name, Walk walk) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = walk();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-8s %12llu nodes %9.3f s %12.0f nodes/s\n", name,
+                    static_cast<unsigned long long>(nodes), seconds, nodes / seconds);
+    }
+}
+
+int main(int argc, char** argv) {
+    int depth = argc > 1 ? std::atoi(argv[1]) : 9;
+    
+#ifdef MANCALA_SWAR_BOARD
+    std::printf("board: swar, depth %d\n", depth);
+#else
+    std::printf("board: scalar, depth %d\n", depth);
+#endif
+    
+    MancalaBoard board;
+    board.reset();
+    report("perft", [&]() { return perft(board, depth); });
+    
+    uint64_t hash = Zobrist::hash(board);
+    report("hashed", [&]() { return perftHashed(board, hash, depth); });
+    
+    return 0;
+}
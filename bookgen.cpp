@@ -0,0 +1,150 @@
+// Opening book generator.
+//
+// Collects every position reachable from the start position within the
+// given number of sowings (so extra-turn chains count one ply per sowing
+// and their intermediate positions are included), searches each one to a
+// fixed depth, and writes the book MancalaAI memory-maps at startup (see
+// openingbook.h). Positions are searched in parallel, one MancalaAI per
+// worker thread.
+//
+// Usage: bookgen <plies> <depth> <output file> [threads] [tablebase file]
+
+#include "ai.h"
+#include "board.h"
+#include "openingbook.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    struct BookPosition {
+        MancalaBoard board;
+        uint64_t key;
+        OpeningBook::Move move;
+    };
+    
+    // Breadth-first walk over all move sequences up to plies sowings,
+    // keeping each distinct unfinished position once
+    std::vector<BookPosition> collectPositions(int plies) {
+        MancalaBoard start;
+        start.reset();
+        
+        std::vector<BookPosition> positions;
+        std::unordered_set<uint64_t> seen;
+        std::vector<MancalaBoard> frontier(1, start);
+        seen.insert(Zobrist::hash(start));
+        
+        for (int ply = 0; ply <= plies; ply++) {
+            std::vector<MancalaBoard> next;
+            for (const MancalaBoard& board : frontier) {
+                BookPosition position = { board, Zobrist::hash(board), { -1, 0 } };
+                positions.push_back(position);
+                if (ply == plies) {
+                    continue;
+                }
+                
+                int moves[MancalaBoard::PITS_PER_PLAYER];
+                int moveCount = board.getPossibleMoves(moves);
+                for (int i = 0; i < moveCount; i++) {
+                    MancalaBoard child = board;
+                    child.makeMove(moves[i]);
+                    if (!child.isGameOver() && seen.insert(Zobrist::hash(child)).second) {
+                        next.push_back(child);
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+        
+        return positions;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::fprintf(stderr, "Usage: %s <plies> <depth> <output file> [threads] [tablebase file]\n", argv[0]);
+        return 1;
+    }
+    
+    int plies = std::max(0, std::atoi(argv[1]));
+    int depth = std::max(1, std::atoi(argv[2]));
+    const char* outputPath = argv[3];
+    // Threads: 0 or missing uses every core
+    int threadCount = argc > 4 ? std::atoi(argv[4]) : 0;
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, threadCount);
+    const char* tablebasePath = argc > 5 ? argv[5] : nullptr;
+    
+    std::vector<BookPosition> positions = collectPositions(plies);
+    std::printf("%zu positions within %d plies, searching to depth %d on %d threads\n",
+                positions.size(), plies, depth, threadCount);
+    
+    // Workers take the next unsearched position until none are left
+    std::atomic<size_t> nextPosition(0);
+    std::mutex progressMutex;
+    size_t searched = 0;
+    auto start = std::chrono::steady_clock::now();
+    
+    auto work = [&]() {
+        MancalaAI ai;
+        ai.setSearchDepth(depth);
+        if (tablebasePath != nullptr) {
+            ai.loadTablebase(tablebasePath);
+        }
+        
+        for (size_t i = nextPosition++; i < positions.size(); i = nextPosition++) {
+            BookPosition& position = positions[i];
+            position.move.pit = static_cast<int8_t>(ai.findBestMove(position.board));
+            position.move.depth = static_cast<uint8_t>(ai.getLastSearchDepth());
+            
+            std::lock_guard<std::mutex> lock(progressMutex);
+            searched++;
+            if (searched % 1000 == 0 || searched == positions.size()) {
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::printf("%zu / %zu searched, %.1f s\n", searched, positions.size(), seconds);
+                std::fflush(stdout);
+            }
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    
+    // Sorted by key for binary search
+    std::sort(positions.begin(), positions.end(), [](const BookPosition& a, const BookPosition& b) {
+        return a.key < b.key;
+    });
+    
+    OpeningBook::Header header = OpeningBook::makeHeader(static_cast<uint32_t>(plies), positions.size());
+    std::ofstream out(outputPath, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const BookPosition& position : positions) {
+        out.write(reinterpret_cast<const char*>(&position.key), sizeof(position.key));
+    }
+    for (const BookPosition& position : positions) {
+        out.write(reinterpret_cast<const char*>(&position.move), sizeof(position.move));
+    }
+    if (!out) {
+        std::fprintf(stderr, "Failed to write %s\n", outputPath);
+        return 1;
+    }
+    
+    std::printf("Wrote %s (%zu entries)\n", outputPath, positions.size());
+    return 0;
+}
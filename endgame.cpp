@@ -0,0 +1,138 @@
+#include "endgame.h"
+#include <cstring>
+
+namespace {
+    const char MAGIC[8] = { 'M', 'N', 'C', 'L', 'E', 'G', 'T', 'B' };
+    
+    // Binomial coefficients C(n, k) for every n and k the index needs
+    const int MAX_N = EndgameTablebase::MAX_STONES + EndgameTablebase::KEY_PITS;
+    
+    struct Binomials {
+        uint64_t c[MAX_N + 1][EndgameTablebase::KEY_PITS + 1];
+        
+        Binomials() {
+            std::memset(c, 0, sizeof(c));
+            for (int n = 0; n <= MAX_N; n++) {
+                c[n][0] = 1;
+                for (int k = 1; k <= EndgameTablebase::KEY_PITS && k <= n; k++) {
+                    c[n][k] = c[n - 1][k - 1] + (k < n ? c[n - 1][k] : 0);
+                }
+            }
+        }
+    };
+    
+    const Binomials binomials;
+    
+    uint64_t choose(int n, int k) {
+        return (n < 0 || k < 0 || k > n) ? 0 : binomials.c[n][k];
+    }
+}
+
+EndgameTablebase::EndgameTablebase() : values(nullptr), maxStones(0) {
+}
+
+bool EndgameTablebase::open(const std::string& path) {
+    close();
+    
+    if (!file.open(path)) {
+        return false;
+    }
+    
+    Header header;
+    if (file.size() < sizeof(Header)) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(Header));
+    
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header.version == VERSION &&
+                 header.maxStones <= static_cast<uint32_t>(MAX_STONES) &&
+                 header.entryCount == entryCount(header.maxStones) &&
+                 file.size() >= sizeof(Header) + header.entryCount;
+    if (!valid) {
+        file.close();
+        return false;
+    }
+    
+    values = reinterpret_cast<const int8_t*>(file.data() + sizeof(Header));
+    maxStones = static_cast<int>(header.maxStones);
+    return true;
+}
+
+void EndgameTablebase::close() {
+    file.close();
+    values = nullptr;
+    maxStones = 0;
+}
+
+bool EndgameTablebase::probe(const MancalaBoard& board, int& moverMargin) const {
+    if (values == nullptr) {
+        return false;
+    }
+    
+    int key[KEY_PITS];
+    makeKey(board, key);
+    
+    int stones = 0;
+    for (int i = 0; i < KEY_PITS; i++) {
+        stones += key[i];
+    }
+    if (stones > maxStones) {
+        return false;
+    }
+    
+    moverMargin = values[index(key)];
+    return true;
+}
+
+void EndgameTablebase::makeKey(const MancalaBoard& board, int key[KEY_PITS]) {
+    // The board is symmetric under a rotation by seven pits, so Player 2's
+    // pits 7-12 play exactly like Player 1's pits 0-5
+    int moverStart = board.isPlayer1Turn() ? 0 : MancalaBoard::PLAYER1_STORE + 1;
+    int opponentStart = board.isPlayer1Turn() ? MancalaBoard::PLAYER1_STORE + 1 : 0;
+    
+    for (int i = 0; i < MancalaBoard::PITS_PER_PLAYER; i++) {
+        key[i] = board.pits[moverStart + i];
+        key[MancalaBoard::PITS_PER_PLAYER + i] = board.pits[opponentStart + i];
+    }
+}
+
+uint64_t EndgameTablebase::index(const int key[KEY_PITS]) {
+    int stones = 0;
+    for (int i = 0; i < KEY_PITS; i++) {
+        stones += key[i];
+    }
+    
+    // Lexicographic rank among the compositions of the same stone count:
+    // for each pit, count the compositions that put fewer stones there.
+    // Summed over those smaller values this telescopes to a difference of
+    // two binomials.
+    uint64_t rank = 0;
+    int remaining = stones;
+    for (int i = 0; i < KEY_PITS - 1; i++) {
+        int laterPits = KEY_PITS - 1 - i;
+        rank += choose(remaining + laterPits, laterPits) - choose(remaining - key[i] + laterPits, laterPits);
+        remaining -= key[i];
+    }
+    
+    return entryCount(stones - 1) + rank;
+}
+
+uint64_t EndgameTablebase::compositions(int stones, int pits) {
+    return choose(stones + pits - 1, pits - 1);
+}
+
+uint64_t EndgameTablebase::entryCount(int maxStones) {
+    // Compositions of at most maxStones into KEY_PITS parts
+    return choose(maxStones + KEY_PITS, KEY_PITS);
+}
+
+EndgameTablebase::Header EndgameTablebase::makeHeader(int maxStones) {
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.maxStones = static_cast<uint32_t>(maxStones);
+    header.entryCount = entryCount(maxStones);
+    return header;
+}
@@ -0,0 +1,74 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include "board.h"
+#include "mappedfile.h"
+#include <cstdint>
+#include <string>
+
+// Exact endgame values for every position with up to getMaxStones() stones
+// left in the small pits, read from a file written by the tbgen tool.
+//
+// The rules never look at the stores, so a position is keyed only by its 12
+// small pits, seen from the side to move: the mover's six pits first, then
+// the opponent's. The stored value is the final store difference (mover
+// minus opponent) the mover gets from the remaining stones with best play.
+// Positions are ranked perfectly: all positions with fewer stones come
+// first, then the compositions of the same stone count in lexicographic
+// order, so the file is one signed byte per position with no gaps.
+class EndgameTablebase {
+public:
+    // Largest stone count the index arithmetic supports
+    static const int MAX_STONES = MancalaBoard::TOTAL_STONES;
+    
+    // Small pits in a key: the mover's side, then the opponent's
+    static const int KEY_PITS = 2 * MancalaBoard::PITS_PER_PLAYER;
+    
+    // File layout: this header, then entryCount(maxStones) int8_t values
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t maxStones;
+        uint64_t entryCount;
+    };
+    
+    static const uint32_t VERSION = 1;
+    
+    EndgameTablebase();
+    
+    // Memory-map a tablebase file; returns false if it is missing or invalid
+    bool open(const std::string& path);
+    void close();
+    
+    bool isOpen() const { return values != nullptr; }
+    int getMaxStones() const { return maxStones; }
+    
+    // Exact final store difference, from the side to move's point of view,
+    // still to be made from the stones in the small pits. Returns false if
+    // the position has more stones than the table covers.
+    bool probe(const MancalaBoard& board, int& moverMargin) const;
+    
+    // Index helpers, shared with the generator
+    
+    // Fill key with the small pits as seen from the side to move
+    static void makeKey(const MancalaBoard& board, int key[KEY_PITS]);
+    
+    // Position of key in the table; key must hold at most MAX_STONES stones
+    static uint64_t index(const int key[KEY_PITS]);
+    
+    // Ways to spread the given number of stones over the given number of pits
+    static uint64_t compositions(int stones, int pits);
+    
+    // Number of positions with at most the given number of stones
+    static uint64_t entryCount(int maxStones);
+    
+    // Header for a table covering up to maxStones stones
+    static Header makeHeader(int maxStones);
+    
+private:
+    MappedFile file;
+    const int8_t* values;
+    int maxStones;
+};
+
+#endif // ENDGAME_H
@@ -0,0 +1,48 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "board.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// What the GUI and the headless tools need from a move searcher, so they
+// can pick MancalaAI (alpha-beta) or MCTSEngine at runtime. Board is the
+// variant searched, chosen at runtime with withVariant (variant.h).
+template <class Board>
+class BasicEngine {
+public:
+    virtual ~BasicEngine() {}
+    
+    // Best move for the side to move, searched as far as the difficulty allows
+    virtual int findBestMove(const Board& board) = 0;
+    
+    // Best move found within a wall-clock budget
+    virtual int findBestMove(const Board& board, std::chrono::milliseconds budget) = 0;
+    
+    // Ask a running search (from another thread) to return as soon as
+    // possible. The request sticks until resetStop() is called.
+    virtual void stop() = 0;
+    virtual void resetStop() = 0;
+    
+    // Difficulty 1-5
+    virtual void setDifficulty(int difficulty) = 0;
+    
+    // Number of threads searching in parallel
+    virtual void setThreads(int count) = 0;
+    
+    // Depth reached by the last search, in plies
+    virtual int getLastSearchDepth() const = 0;
+    
+    // Positions (alpha-beta) or playouts (MCTS) of the last search
+    virtual uint64_t getLastSearchNodes() const = 0;
+    
+    // Optional precomputed data; engines that cannot use it, and variants
+    // it does not cover, return false
+    virtual bool loadTablebase(const std::string&) { return false; }
+    virtual bool loadOpeningBook(const std::string&) { return false; }
+};
+
+typedef BasicEngine<MancalaBoard> Engine;
+
+#endif // ENGINE_H
@@ -0,0 +1,114 @@
+#include "evalfeatures.h"
+
+namespace {
+    // Per-pit lookups, built once per variant so neither setPit nor the leaf
+    // scan does any modulo arithmetic
+    template <class Board>
+    struct Tables {
+        static const int MAX_STONES = Board::TOTAL_STONES;
+        
+        int8_t side[Board::TOTAL_PITS];        // 0 Player 1, 1 Player 2, -1 store
+        int8_t opposing[Board::TOTAL_PITS];    // getOpposingPit, -1 for stores
+        int8_t storeDistance[Board::TOTAL_PITS];
+        int8_t landing[Board::TOTAL_PITS][MAX_STONES + 1];
+        
+        Tables() {
+            for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+                side[pit] = pit < Board::PLAYER1_STORE ? 0 :
+                            (pit > Board::PLAYER1_STORE && pit < Board::PLAYER2_STORE) ? 1 : -1;
+                opposing[pit] = static_cast<int8_t>(Board::getOpposingPit(pit));
+            }
+            
+            for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+                int store = side[pit] == 0 ? Board::PLAYER1_STORE : Board::PLAYER2_STORE;
+                storeDistance[pit] = static_cast<int8_t>((store - pit + Board::TOTAL_PITS) % Board::TOTAL_PITS);
+                
+                // Own small pit the stones land on, as counted by the capture
+                // heuristic (a plain walk around all the pits), or -1
+                for (int stones = 0; stones <= MAX_STONES; stones++) {
+                    int target = (pit + stones) % Board::TOTAL_PITS;
+                    bool lands = side[pit] >= 0 && stones > 0 && stones < Board::TOTAL_PITS &&
+                                 side[target] == side[pit];
+                    landing[pit][stones] = static_cast<int8_t>(lands ? target : -1);
+                }
+            }
+        }
+        
+        static const Tables instance;
+    };
+    
+    template <class Board>
+    const Tables<Board> Tables<Board>::instance;
+}
+
+template <class Board>
+BasicEvalFeatures<Board> BasicEvalFeatures<Board>::compute(const Board& board) {
+    const Tables<Board>& tables = Tables<Board>::instance;
+    BasicEvalFeatures features = {};
+    
+    for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+        int side = tables.side[pit];
+        if (side < 0) {
+            continue;
+        }
+        
+        int stones = board.pits[pit];
+        features.sideStones[side] += stones;
+        features.nonEmptyPits[side] += stones > 0;
+        features.extraTurnPits[side] += stones == tables.storeDistance[pit];
+    }
+    
+    return features;
+}
+
+template <class Board>
+void BasicEvalFeatures<Board>::setPit(uint8_t* pits, int pit, int stones) {
+    const Tables<Board>& tables = Tables<Board>::instance;
+    int side = tables.side[pit];
+    if (side >= 0) {
+        int oldStones = pits[pit];
+        sideStones[side] += stones - oldStones;
+        nonEmptyPits[side] += (stones > 0) - (oldStones > 0);
+        extraTurnPits[side] += (stones == tables.storeDistance[pit]) - (oldStones == tables.storeDistance[pit]);
+    }
+    
+    // Stores are read straight from the board
+    pits[pit] = static_cast<uint8_t>(stones);
+}
+
+template <class Board>
+int BasicEvalFeatures<Board>::capturePotential(const Board& board, int side) {
+    const Tables<Board>& tables = Tables<Board>::instance;
+    int start = side == 0 ? 0 : Board::PLAYER1_STORE + 1;
+    int end = start + Board::PITS_PER_PLAYER;
+    int score = 0;
+    
+    for (int pit = start; pit < end; pit++) {
+        int target = tables.landing[pit][board.pits[pit]];
+        if (target >= 0 && board.pits[target] == 0) {
+            int opposingStones = board.pits[tables.opposing[target]];
+            if (opposingStones > 0) {
+                score += opposingStones + 1;  // +1 for the capturing stone
+            }
+        }
+    }
+    
+    return score;
+}
+
+template <class Board>
+bool BasicEvalFeatures<Board>::matches(const Board& board) const {
+    BasicEvalFeatures expected = compute(board);
+    for (int side = 0; side < 2; side++) {
+        if (expected.sideStones[side] != sideStones[side] ||
+            expected.nonEmptyPits[side] != nonEmptyPits[side] ||
+            expected.extraTurnPits[side] != extraTurnPits[side]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#define INSTANTIATE_FEATURES(PITS, STONES) template struct BasicEvalFeatures<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_FEATURES)
+#undef INSTANTIATE_FEATURES
@@ -0,0 +1,34 @@
+#ifndef EVALFEATURES_H
+#define EVALFEATURES_H
+
+#include "board.h"
+#include <cstdint>
+
+// Raw inputs of MancalaAI's evaluation, kept up to date pit by pit while
+// makeMove sows and captures, so scoring a leaf needs no full board scan.
+// Index 0 is Player 1's side, index 1 Player 2's side.
+template <class Board>
+struct BasicEvalFeatures {
+    int16_t sideStones[2];      // Stones in the small pits of each side
+    int8_t nonEmptyPits[2];     // Small pits holding at least one stone
+    int8_t extraTurnPits[2];    // Pits whose stone count reaches the own store exactly
+    
+    // Full recomputation from a board
+    static BasicEvalFeatures compute(const Board& board);
+    
+    // Set pits[pit] to stones and update the features to match
+    void setPit(uint8_t* pits, int pit, int stones);
+    
+    // Stones the given side could capture with one move: for every own pit
+    // ending in an empty own pit, the opposing stones plus the landing stone.
+    // Captures depend on pairs of pits, so this is a scan of the side's pits
+    // at the leaf rather than an incremental feature.
+    static int capturePotential(const Board& board, int side);
+    
+    // Debug check: true if the incremental state equals a full recomputation
+    bool matches(const Board& board) const;
+};
+
+typedef BasicEvalFeatures<MancalaBoard> EvalFeatures;
+
+#endif // EVALFEATURES_H
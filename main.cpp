@@ -3,6 +3,9 @@
 #include <string>
 #include "mancala.h"
 #include "ai.h"
+#include "aiworker.h"
+#include "mcts.h"
+#include "variant.h"
 
 // Game states
 enum class GameState {
@@ -11,6 +14,35 @@ enum class GameState {
     GAME_OVER
 };
 
+// Sowing animation speeds offered in the menu, as time per pit a stone
+// travels; zero shows moves at once
+const int ANIMATION_SPEEDS = 3;
+const sf::Int32 ANIMATION_STEP_MS[ANIMATION_SPEEDS] = { 120, 40, 0 };
+const char* const ANIMATION_LABELS[ANIMATION_SPEEDS] = { "Animation: Normal", "Animation: Fast", "Animation: Off" };
+
+// How often the loop checks on a running AI search when nothing needs
+// repainting; the window waits for events instead when no search runs
+const sf::Time AI_POLL_INTERVAL = sf::milliseconds(16);
+
+// Board variants offered in the menu, in MANCALA_VARIANTS order
+struct Variant {
+    int pits;
+    int stones;
+};
+#define VARIANT_ENTRY(PITS, STONES) { PITS, STONES },
+const Variant VARIANTS[] = { MANCALA_VARIANTS(VARIANT_ENTRY) };
+#undef VARIANT_ENTRY
+const int VARIANT_COUNT = sizeof(VARIANTS) / sizeof(VARIANTS[0]);
+
+// Menu choices, kept when the variant changes and its session restarts
+struct Settings {
+    int variant = 0;            // Index into VARIANTS
+    bool useMCTS = false;       // Engine: Monte Carlo tree search instead of minimax
+    bool pondering = true;      // Search the AI's replies while the human thinks
+    int animationSpeed = 0;     // Index into ANIMATION_STEP_MS
+    std::string hashFile;       // Minimax table kept between sessions, if set
+};
+
 // Button class for menu interface
 class Button {
 public:
@@ -22,15 +54,21 @@ public:
         shape.setOutlineColor(sf::Color::Black);
         
         this->text.setFont(font);
-        this->text.setString(text);
         this->text.setCharacterSize(20);
         this->text.setFillColor(sf::Color::Black);
+        setText(text);
+    }
+    
+    void setText(const std::string& text) {
+        this->text.setString(text);
         
         // Center text in button
+        sf::Vector2f position = shape.getPosition();
+        sf::Vector2f size = shape.getSize();
         sf::FloatRect textBounds = this->text.getLocalBounds();
         this->text.setPosition(
-            x + (width - textBounds.width) / 2,
-            y + (height - textBounds.height) / 2 - 5 // Small adjustment for visual alignment
+            position.x + (size.x - textBounds.width) / 2,
+            position.y + (size.y - textBounds.height) / 2 - 5 // Small adjustment for visual alignment
         );
     }
     
@@ -46,78 +84,178 @@ public:
         window.draw(text);
     }
     
-    void setHighlight(bool highlight) {
+    // Returns whether the highlight changed, so the window needs repainting
+    bool setHighlight(bool highlight) {
+        if (highlight == highlighted) {
+            return false;
+        }
+        highlighted = highlight;
         if (highlight) {
             shape.setFillColor(sf::Color(150, 150, 255));
         } else {
             shape.setFillColor(sf::Color(200, 200, 255));
         }
+        return true;
     }
     
 private:
     sf::RectangleShape shape;
     sf::Text text;
+    bool highlighted = false;
 };
 
-int main() {
-    // Create the game window
-    sf::RenderWindow window(sf::VideoMode(800, 600), "Mancala Game");
-    window.setFramerateLimit(60);
-    
-    // Load font
-    sf::Font font;
-    if (!font.loadFromFile("assets/arial.ttf")) {
-        std::cout << "Error loading font. Using system default." << std::endl;
-        // Continue without a font - SFML will use a default font
-    }
-    
+// Text with its style and position set once up front
+sf::Text makeText(const sf::Font& font, const std::string& string, unsigned int size, sf::Color color, float x, float y) {
+    sf::Text text;
+    text.setFont(font);
+    text.setString(string);
+    text.setCharacterSize(size);
+    text.setFillColor(color);
+    text.setPosition(x, y);
+    return text;
+}
+
+// Menu label of a variant, e.g. "Board: Kalah(6,4)"
+std::string variantLabel(const Variant& variant) {
+    return "Board: Kalah(" + std::to_string(variant.pits) + "," + std::to_string(variant.stones) + ")";
+}
+
+// Play one board variant in the window until it is closed or another
+// variant is picked in the menu; the menu choices live on in settings
+template <class Board>
+void runVariant(sf::RenderWindow& window, const sf::Font& font, Settings& settings) {
     // Game objects
-    MancalaGame game;
-    MancalaAI ai(3); // Medium difficulty AI
+    BasicMancalaGame<Board> game;
+    BasicMancalaAI<Board> ai(3); // Medium difficulty AI
+    ai.loadTablebase("assets/endgame.tb"); // Optional, generated with tbgen; 6,4 only
+    ai.loadOpeningBook("assets/opening.book"); // Optional, generated with bookgen; 6,4 only
+    if (!settings.hashFile.empty()) {
+        ai.loadHash(settings.hashFile); // Missing on the first session, or saved for another variant
+    }
+    BasicMCTSEngine<Board> mcts(3); // Alternative engine, picked in the menu
+    BasicEngine<Board>* engine = settings.useMCTS ? static_cast<BasicEngine<Board>*>(&mcts) : &ai;
+    BasicAIWorker<Board> aiWorker(*engine); // Runs AI searches off the event loop
+    sf::Clock frameClock; // Time since the last loop iteration, drives the animation
     
     // Menu buttons
     Button easyButton(300, 200, 200, 50, "Easy AI", font);
     Button mediumButton(300, 275, 200, 50, "Medium AI", font);
     Button hardButton(300, 350, 200, 50, "Hard AI", font);
     Button quitButton(300, 425, 200, 50, "Quit", font);
+    Button variantButton(25, 500, 180, 50, variantLabel(VARIANTS[settings.variant]), font);
+    Button engineButton(215, 500, 180, 50, settings.useMCTS ? "Engine: MCTS" : "Engine: Minimax", font);
+    Button ponderButton(405, 500, 180, 50, settings.pondering ? "Pondering: On" : "Pondering: Off", font);
+    Button animationButton(595, 500, 180, 50, ANIMATION_LABELS[settings.animationSpeed], font);
+    Button* menuButtons[] = { &easyButton, &mediumButton, &hardButton, &quitButton, &variantButton, &engineButton,
+                              &ponderButton, &animationButton };
+    
+    // Fixed texts
+    sf::Text titleText = makeText(font, "Mancala Game", 40, sf::Color::Black, 270, 100);
+    sf::Text subtitleText = makeText(font, "Select Difficulty:", 24, sf::Color::Black, 310, 160);
+    sf::Text continueText = makeText(font, "Click anywhere to return to the menu", 20, sf::Color::Blue, 250, 500);
     
     // Game state
     GameState state = GameState::MENU;
     int aiDifficulty = 3; // Default medium
+    bool variantChosen = false; // Another variant was picked; its own session takes over
+    bool redraw = true; // Something on screen changed since the last frame
     
     // Game loop
-    while (window.isOpen()) {
+    while (window.isOpen() && !variantChosen) {
+        // Advance the sowing animation; every frame it plays is repainted,
+        // including the one where it finishes
+        if (game.isAnimating()) {
+            game.update(frameClock.restart());
+            redraw = true;
+        } else {
+            frameClock.restart();
+        }
+        
+        // Only the AI's turn needs the loop to keep running on its own;
+        // otherwise nothing changes until the next event, so wait for it
+        bool aiTurn = state == GameState::PLAYING && !game.isPlayer1Turn();
         sf::Event event;
-        while (window.pollEvent(event)) {
+        bool gotEvent = (redraw || aiTurn) ? window.pollEvent(event) : window.waitEvent(event);
+        for (; gotEvent; gotEvent = window.pollEvent(event)) {
+            // Mouse movement only matters where it changes a highlight
+            if (event.type == sf::Event::MouseMoved) {
+                if (state == GameState::MENU) {
+                    for (Button* button : menuButtons) {
+                        redraw |= button->setHighlight(button->isMouseOver(window));
+                    }
+                }
+                continue;
+            }
+            redraw = true;
+            
             if (event.type == sf::Event::Closed) {
+                aiWorker.cancel();
                 window.close();
             }
             
+            // Escape leaves a game in progress and returns to the menu
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape &&
+                state == GameState::PLAYING) {
+                aiWorker.cancel();
+                game.finishAnimation();
+                state = GameState::MENU;
+            }
+            
             // Handle mouse clicks
             if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
                 if (state == GameState::MENU) {
                     // Handle menu button clicks
                     if (easyButton.isMouseOver(window)) {
                         aiDifficulty = 1;
-                        ai.setDifficulty(aiDifficulty);
-                        game = MancalaGame(); // Reset game
+                        engine->setDifficulty(aiDifficulty);
+                        game = BasicMancalaGame<Board>(); // Reset game
+                        game.setStepTime(sf::milliseconds(ANIMATION_STEP_MS[settings.animationSpeed]));
                         state = GameState::PLAYING;
                     }
                     else if (mediumButton.isMouseOver(window)) {
                         aiDifficulty = 3;
-                        ai.setDifficulty(aiDifficulty);
-                        game = MancalaGame(); // Reset game
+                        engine->setDifficulty(aiDifficulty);
+                        game = BasicMancalaGame<Board>(); // Reset game
+                        game.setStepTime(sf::milliseconds(ANIMATION_STEP_MS[settings.animationSpeed]));
                         state = GameState::PLAYING;
                     }
                     else if (hardButton.isMouseOver(window)) {
                         aiDifficulty = 5;
-                        ai.setDifficulty(aiDifficulty);
-                        game = MancalaGame(); // Reset game
+                        engine->setDifficulty(aiDifficulty);
+                        game = BasicMancalaGame<Board>(); // Reset game
+                        game.setStepTime(sf::milliseconds(ANIMATION_STEP_MS[settings.animationSpeed]));
                         state = GameState::PLAYING;
                     }
                     else if (quitButton.isMouseOver(window)) {
+                        aiWorker.cancel();
                         window.close();
                     }
+                    else if (variantButton.isMouseOver(window)) {
+                        // The next variant is played by another instantiation,
+                        // so leave this session for main to start that one
+                        settings.variant = (settings.variant + 1) % VARIANT_COUNT;
+                        variantChosen = true;
+                        break;
+                    }
+                    else if (engineButton.isMouseOver(window)) {
+                        // Switch between alpha-beta and Monte Carlo tree search
+                        settings.useMCTS = !settings.useMCTS;
+                        engine = settings.useMCTS ? static_cast<BasicEngine<Board>*>(&mcts) : &ai;
+                        engineButton.setText(settings.useMCTS ? "Engine: MCTS" : "Engine: Minimax");
+                        aiWorker.setEngine(*engine);
+                    }
+                    else if (ponderButton.isMouseOver(window)) {
+                        settings.pondering = !settings.pondering;
+                        ponderButton.setText(settings.pondering ? "Pondering: On" : "Pondering: Off");
+                    }
+                    else if (animationButton.isMouseOver(window)) {
+                        settings.animationSpeed = (settings.animationSpeed + 1) % ANIMATION_SPEEDS;
+                        animationButton.setText(ANIMATION_LABELS[settings.animationSpeed]);
+                    }
+                }
+                else if (game.isAnimating()) {
+                    // A click while moves play back skips to the current position
+                    game.finishAnimation();
                 }
                 else if (state == GameState::PLAYING) {
                     // Handle game board clicks
@@ -127,22 +265,14 @@ int main() {
                         int selectedPit = game.getPitFromMousePosition(mouseX, mouseY);
                         
                         if (selectedPit >= 0 && game.isValidMove(selectedPit)) {
-                            bool extraTurn = game.makeMove(selectedPit);
+                            game.makeMove(selectedPit);
                             
-                            // Check if game is over after human move
+                            // Check if game is over after human move; otherwise
+                            // the AI starts thinking below if it is its turn
                             if (game.isGameOver()) {
+                                aiWorker.cancel(); // Stop pondering
                                 state = GameState::GAME_OVER;
                             }
-                            else if (!extraTurn && !game.isPlayer1Turn()) {
-                                // AI's turn after human move
-                                sf::sleep(sf::milliseconds(500)); // Small delay before AI move
-                                processAIMove(game, ai);
-                                
-                                // Check if game is over after AI move
-                                if (game.isGameOver()) {
-                                    state = GameState::GAME_OVER;
-                                }
-                            }
                         }
                     }
                 }
@@ -153,82 +283,108 @@ int main() {
             }
         }
         
-        // Render
-        window.clear(sf::Color(240, 240, 240));
-        
-        if (state == GameState::MENU) {
-            // Draw menu title
-            sf::Text titleText;
-            titleText.setFont(font);
-            titleText.setString("Mancala Game");
-            titleText.setCharacterSize(40);
-            titleText.setFillColor(sf::Color::Black);
-            titleText.setPosition(270, 100);
-            window.draw(titleText);
-            
-            // Draw subtitle
-            sf::Text subtitleText;
-            subtitleText.setFont(font);
-            subtitleText.setString("Select Difficulty:");
-            subtitleText.setCharacterSize(24);
-            subtitleText.setFillColor(sf::Color::Black);
-            subtitleText.setPosition(310, 160);
-            window.draw(subtitleText);
+        // Render, only when something changed
+        if (redraw && window.isOpen() && !variantChosen) {
+            redraw = false;
             
-            // Update button highlights
-            easyButton.setHighlight(easyButton.isMouseOver(window));
-            mediumButton.setHighlight(mediumButton.isMouseOver(window));
-            hardButton.setHighlight(hardButton.isMouseOver(window));
-            quitButton.setHighlight(quitButton.isMouseOver(window));
+            if (state == GameState::MENU) {
+                window.clear(sf::Color(240, 240, 240));
+                window.draw(titleText);
+                window.draw(subtitleText);
+                
+                // Highlights follow the mouse, also when it was moved outside the menu
+                for (Button* button : menuButtons) {
+                    button->setHighlight(button->isMouseOver(window));
+                    button->draw(window);
+                }
+            }
+            else if (state == GameState::PLAYING || state == GameState::GAME_OVER) {
+                // Draw the game board
+                game.displayBoard(window, font);
+                
+                if (state == GameState::GAME_OVER && !game.isAnimating()) {
+                    window.draw(continueText);
+                }
+            }
             
-            // Draw buttons
-            easyButton.draw(window);
-            mediumButton.draw(window);
-            hardButton.draw(window);
-            quitButton.draw(window);
+            window.display();
         }
-        else if (state == GameState::PLAYING || state == GameState::GAME_OVER) {
-            // Draw the game board
-            game.displayBoard(window, font);
-            
-            if (state == GameState::GAME_OVER) {
-                // Draw "click to continue" message
-                sf::Text continueText;
-                continueText.setFont(font);
-                continueText.setString("Click anywhere to return to the menu");
-                continueText.setCharacterSize(20);
-                continueText.setFillColor(sf::Color::Blue);
-                continueText.setPosition(250, 500);
-                window.draw(continueText);
-            }
+        else if (aiTurn) {
+            // Nothing to repaint while the AI thinks; check on it again shortly
+            sf::sleep(AI_POLL_INTERVAL);
         }
         
-        window.display();
+        // While the human thinks, search the AI's replies to each of their
+        // moves; the AI's turn below then starts from those results
+        if (state == GameState::PLAYING && game.isPlayer1Turn() && settings.pondering) {
+            aiWorker.ponder(game.getBoard());
+        }
         
-        // If it's AI's turn in playing state, process AI move
+        // If it's AI's turn in playing state, search in the background and
+        // apply the move once it is ready. The search starts as soon as the
+        // board changes, so it runs while the previous move is still being
+        // animated; its own move is queued behind that one.
         if (state == GameState::PLAYING && !game.isPlayer1Turn()) {
-            processAIMove(game, ai);
-            
-            // Check if game is over after AI move
-            if (game.isGameOver()) {
-                state = GameState::GAME_OVER;
+            if (!aiWorker.isBusy()) {
+                aiWorker.start(game.getBoard());
+            }
+            else if (aiWorker.isReady()) {
+                int aiMove = aiWorker.takeMove();
+                if (aiMove >= 0) {
+                    game.makeMove(aiMove);
+                }
+                redraw = true;
+                
+                // If AI gets an extra turn, it will search again on the next loop iteration
+                if (game.isGameOver()) {
+                    state = GameState::GAME_OVER;
+                }
             }
         }
     }
     
-    return 0;
+    // No search may run while the table is written
+    aiWorker.cancel();
+    if (!settings.hashFile.empty() && !ai.saveHash(settings.hashFile)) {
+        std::cout << "Could not save " << settings.hashFile << std::endl;
+    }
 }
-
-// Helper function to process AI moves
-void processAIMove(MancalaGame& game, MancalaAI& ai) {
-    // Find and execute the AI's best move
-    int aiMove = ai.findBestMove(game);
+// Usage: mancala [--hash-file FILE]
+//   --hash-file FILE  load the minimax AI's transposition table from FILE at
+//                     startup (if it exists) and save it there at exit, so it
+//                     keeps what it searched between sessions (off by default);
+//                     the file holds the table of the variant played last
+int main(int argc, char* argv[]) {
+    Settings settings;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--hash-file" && i + 1 < argc) {
+            settings.hashFile = argv[++i];
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--hash-file FILE]" << std::endl;
+            return 1;
+        }
+    }
     
-    if (aiMove >= 0) {
-        // Add a small delay to make the AI move visible
-        sf::sleep(sf::milliseconds(500));
-        bool extraTurn = game.makeMove(aiMove);
-        
-        // If AI gets an extra turn, it will continue on the next loop iteration
+    // Create the game window
+    sf::RenderWindow window(sf::VideoMode(800, 600), "Mancala Game");
+    window.setFramerateLimit(60);
+    
+    // Load font
+    sf::Font font;
+    if (!font.loadFromFile("assets/arial.ttf")) {
+        std::cout << "Error loading font. Using system default." << std::endl;
+        // Continue without a font - SFML will use a default font
+    }
+    
+    
+    // Each session runs on the board type of the variant picked in the menu
+    while (window.isOpen()) {
+        const Variant& variant = VARIANTS[settings.variant];
+        withVariant(variant.pits, variant.stones, [&](auto board) {
+            runVariant<decltype(board)>(window, font, settings);
+        });
     }
+    
+    return 0;
 }
\ No newline at end of file
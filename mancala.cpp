@@ -1,253 +1,239 @@
 #include "mancala.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
-MancalaGame::MancalaGame() {
-    // Initialize the board with 4 stones in each small pit
-    for (int i = 0; i < TOTAL_PITS; i++) {
-        if (i == PLAYER1_STORE || i == PLAYER2_STORE) {
-            board[i] = 0;  // Stores start empty
-        } else {
-            board[i] = INITIAL_STONES;
-        }
+namespace {
+    // Segments per circle, as many as sf::CircleShape uses
+    const int CIRCLE_POINTS = 30;
+    
+    const float OUTLINE_THICKNESS = 2.0f;
+    const float HIGHLIGHT_THICKNESS = 3.0f;
+    
+    const sf::Color PLAYER1_PIT_COLOR(200, 255, 200);
+    const sf::Color PLAYER2_PIT_COLOR(255, 255, 200);
+    const sf::Color PLAYER1_STORE_COLOR(200, 200, 255);
+    const sf::Color PLAYER2_STORE_COLOR(255, 200, 200);
+    const sf::Color STONE_COLOR(90, 90, 110);
+    const sf::Color PLAYED_PIT_COLOR(255, 160, 0);
+    const float STONE_RADIUS = 6.0f;
+    
+    // Animation leg lengths, in step times
+    const sf::Time DEFAULT_STEP_TIME = sf::milliseconds(120);
+    const float PAUSE_STEPS = 3.0f;    // Showing the played pit before sowing
+    const float CAPTURE_STEPS = 2.0f;  // Across the board into the store
+    const float SWEEP_STEPS = 2.0f;
+    
+    // Longest frame the animation advances by, so a stalled window does not
+    // jump over it
+    const sf::Time MAX_FRAME_TIME = sf::milliseconds(100);
+    
+    sf::Vector2f circlePoint(sf::Vector2f center, float radius, int index) {
+        float angle = index * 2.0f * 3.14159265f / CIRCLE_POINTS;
+        return sf::Vector2f(center.x + radius * std::cos(angle), center.y + radius * std::sin(angle));
     }
     
-    // Player 1 starts
-    player1Turn = true;
+    void appendTriangle(sf::VertexArray& vertices, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+        vertices.append(sf::Vertex(a, color));
+        vertices.append(sf::Vertex(b, color));
+        vertices.append(sf::Vertex(c, color));
+    }
     
-    // Initialize the GUI components
-    for (int i = 0; i < TOTAL_PITS; i++) {
-        if (i == PLAYER1_STORE) {
-            storeShapes[0].setSize(sf::Vector2f(STORE_WIDTH, STORE_HEIGHT));
-            storeShapes[0].setPosition(BOARD_MARGIN_X + PIT_SPACING * PITS_PER_PLAYER + 20, BOARD_MARGIN_Y);
-            storeShapes[0].setFillColor(sf::Color(200, 200, 255));
-            storeShapes[0].setOutlineColor(sf::Color::Black);
-            storeShapes[0].setOutlineThickness(2.0f);
-        } else if (i == PLAYER2_STORE) {
-            storeShapes[1].setSize(sf::Vector2f(STORE_WIDTH, STORE_HEIGHT));
-            storeShapes[1].setPosition(BOARD_MARGIN_X - STORE_WIDTH - 20, BOARD_MARGIN_Y);
-            storeShapes[1].setFillColor(sf::Color(255, 200, 200));
-            storeShapes[1].setOutlineColor(sf::Color::Black);
-            storeShapes[1].setOutlineThickness(2.0f);
-        } else {
-            pitShapes[i].setRadius(PIT_RADIUS);
-            
-            // Position pits based on their index
-            float x, y;
-            if (i < PLAYER1_STORE) {  // Player 1's pits (bottom row)
-                x = BOARD_MARGIN_X + (PITS_PER_PLAYER - 1 - i) * PIT_SPACING;
-                y = BOARD_MARGIN_Y + PIT_SPACING;
-                pitShapes[i].setFillColor(sf::Color(200, 255, 200));
-            } else {  // Player 2's pits (top row)
-                x = BOARD_MARGIN_X + (i - PLAYER1_STORE - 1) * PIT_SPACING;
-                y = BOARD_MARGIN_Y;
-                pitShapes[i].setFillColor(sf::Color(255, 255, 200));
-            }
-            
-            pitShapes[i].setPosition(x, y);
-            pitShapes[i].setOutlineColor(sf::Color::Black);
-            pitShapes[i].setOutlineThickness(2.0f);
-        }
+    void appendQuad(sf::VertexArray& vertices, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d, sf::Color color) {
+        appendTriangle(vertices, a, b, c, color);
+        appendTriangle(vertices, a, c, d, color);
     }
-}
-
-MancalaGame::~MancalaGame() {
-    // No dynamic allocations to clean up
-}
-
-bool MancalaGame::isPlayer1Turn() const {
-    return player1Turn;
-}
-
-bool MancalaGame::isGameOver() const {
-    // Check if all pits on one side are empty
-    bool player1SideEmpty = true;
-    bool player2SideEmpty = true;
     
-    for (int i = 0; i < PITS_PER_PLAYER; i++) {
-        if (board[i] > 0) {
-            player1SideEmpty = false;
-        }
-        if (board[i + PLAYER1_STORE + 1] > 0) {
-            player2SideEmpty = false;
+    void appendDisc(sf::VertexArray& vertices, sf::Vector2f center, float radius, sf::Color color) {
+        for (int i = 0; i < CIRCLE_POINTS; i++) {
+            appendTriangle(vertices, center, circlePoint(center, radius, i), circlePoint(center, radius, i + 1), color);
         }
     }
     
-    return player1SideEmpty || player2SideEmpty;
-}
-
-int MancalaGame::getWinner() const {
-    if (!isGameOver()) {
-        return 0;  // Game not over yet
+    // Ring outside the given radius, like an sf::Shape outline
+    void appendRing(sf::VertexArray& vertices, sf::Vector2f center, float radius, float thickness, sf::Color color) {
+        for (int i = 0; i < CIRCLE_POINTS; i++) {
+            appendQuad(vertices,
+                       circlePoint(center, radius, i), circlePoint(center, radius + thickness, i),
+                       circlePoint(center, radius + thickness, i + 1), circlePoint(center, radius, i + 1), color);
+        }
     }
     
-    // Count stones in each player's store
-    int player1Score = board[PLAYER1_STORE];
-    int player2Score = board[PLAYER2_STORE];
+    void appendRect(sf::VertexArray& vertices, const sf::FloatRect& rect, sf::Color color) {
+        float right = rect.left + rect.width;
+        float bottom = rect.top + rect.height;
+        appendQuad(vertices,
+                   sf::Vector2f(rect.left, rect.top), sf::Vector2f(right, rect.top),
+                   sf::Vector2f(right, bottom), sf::Vector2f(rect.left, bottom), color);
+    }
     
-    // Include stones remaining on the board in the final score
-    for (int i = 0; i < PITS_PER_PLAYER; i++) {
-        player1Score += board[i];
-        player2Score += board[i + PLAYER1_STORE + 1];
+    // Frame outside the given rectangle, like an sf::Shape outline
+    void appendFrame(sf::VertexArray& vertices, const sf::FloatRect& rect, float thickness, sf::Color color) {
+        float left = rect.left - thickness;
+        float top = rect.top - thickness;
+        float width = rect.width + 2 * thickness;
+        appendRect(vertices, sf::FloatRect(left, top, width, thickness), color);
+        appendRect(vertices, sf::FloatRect(left, rect.top + rect.height, width, thickness), color);
+        appendRect(vertices, sf::FloatRect(left, rect.top, thickness, rect.height), color);
+        appendRect(vertices, sf::FloatRect(rect.left + rect.width, rect.top, thickness, rect.height), color);
     }
     
-    if (player1Score > player2Score) {
-        return 1;  // Player 1 wins
-    } else if (player2Score > player1Score) {
-        return 2;  // Player 2 wins
-    } else {
-        return 0;  // Tie
+    // Center a text on a point, by the extent of its glyphs
+    void centerText(sf::Text& text, sf::Vector2f center) {
+        sf::FloatRect bounds = text.getLocalBounds();
+        text.setPosition(center.x - bounds.width / 2, center.y - bounds.height / 2);
     }
 }
 
-int MancalaGame::getScore(int player) const {
-    if (player == 1) {
-        return board[PLAYER1_STORE];
-    } else {
-        return board[PLAYER2_STORE];
+template <class Board>
+BasicMancalaGame<Board>::BasicMancalaGame()
+    : geometry(sf::Triangles), shownHighlights(-1), shownTurn(0), shownWinner(-1), textFont(nullptr),
+      stepTime(DEFAULT_STEP_TIME), movingGeometry(sf::Triangles) {
+    // Initialize the board with 4 stones in each small pit, Player 1 to move
+    board.reset();
+    
+    // Texts are set up on the first draw, once the font is known
+    for (int i = 0; i < TOTAL_PITS; i++) {
+        shownStones[i] = -1;
+        animatedPits[i] = board.pits[i];
     }
 }
 
-bool MancalaGame::isValidMove(int pit) const {
-    // Check if the pit exists and belongs to the current player
-    if (pit < 0 || pit >= TOTAL_PITS || pit == PLAYER1_STORE || pit == PLAYER2_STORE) {
-        return false;
-    }
-    
-    // Check if the pit belongs to the current player
-    if (player1Turn && pit >= PLAYER1_STORE) {
-        return false;
-    }
-    if (!player1Turn && pit < PLAYER1_STORE) {
-        return false;
-    }
-    
-    // Check if the pit has stones
-    return board[pit] > 0;
+template <class Board>
+BasicMancalaGame<Board>::~BasicMancalaGame() {
+    // No dynamic allocations to clean up
 }
 
-bool MancalaGame::makeMove(int pit) {
+template <class Board>
+bool BasicMancalaGame<Board>::isPlayer1Turn() const {
+    return board.isPlayer1Turn();
+}
+
+template <class Board>
+bool BasicMancalaGame<Board>::isGameOver() const {
+    return board.isGameOver();
+}
+
+template <class Board>
+int BasicMancalaGame<Board>::getWinner() const {
+    return board.getWinner();
+}
+
+template <class Board>
+int BasicMancalaGame<Board>::getScore(int player) const {
+    return board.getScore(player);
+}
+
+template <class Board>
+bool BasicMancalaGame<Board>::isValidMove(int pit) const {
+    return board.isValidMove(pit);
+}
+
+template <class Board>
+bool BasicMancalaGame<Board>::makeMove(int pit) {
     if (!isValidMove(pit)) {
         return false;
     }
     
-    // Pick up all stones from the selected pit
-    int stones = board[pit];
-    board[pit] = 0;
-    
-    int currentPit = pit;
-    
-    // Distribute stones
-    while (stones > 0) {
-        // Move to the next pit
-        currentPit = (currentPit + 1) % TOTAL_PITS;
-        
-        // Skip opponent's store
-        if ((player1Turn && currentPit == PLAYER2_STORE) || 
-            (!player1Turn && currentPit == PLAYER1_STORE)) {
-            continue;
-        }
-        
-        // Drop a stone
-        board[currentPit]++;
-        stones--;
-    }
-    
-    // Check for capture
-    if (board[currentPit] == 1 && isOwnPit(currentPit) && currentPit != PLAYER1_STORE && currentPit != PLAYER2_STORE) {
-        int opposingPit = getOpposingPit(currentPit);
-        if (board[opposingPit] > 0) {
-            // Capture the stones
-            int playerStore = player1Turn ? PLAYER1_STORE : PLAYER2_STORE;
-            board[playerStore] += board[opposingPit] + 1;  // Opposing stones + the last stone placed
-            board[opposingPit] = 0;
-            board[currentPit] = 0;
-        }
-    }
-    
-    // Check if the game is over
-    if (isGameOver()) {
-        collectRemainingStones();
-        return true;
-    }
+    Board before = board;
+    typename Board::Undo undo;
+    board.makeMove(pit, undo);
     
-    // Extra turn if last stone lands in player's store
-    if ((player1Turn && currentPit == PLAYER1_STORE) || 
-        (!player1Turn && currentPit == PLAYER2_STORE)) {
-        return true;  // Player gets another turn
+    if (stepTime == sf::Time::Zero) {
+        finishAnimation();
+    } else {
+        queueMove(before, undo);
     }
-    
-    // Switch turns
-    player1Turn = !player1Turn;
     return true;
 }
 
-int MancalaGame::getStonesInPit(int pit) const {
-    if (pit >= 0 && pit < TOTAL_PITS) {
-        return board[pit];
-    }
-    return 0;
+template <class Board>
+int BasicMancalaGame<Board>::getStonesInPit(int pit) const {
+    return board.getStonesInPit(pit);
 }
 
-std::vector<int> MancalaGame::getPossibleMoves() const {
-    std::vector<int> moves;
-    
-    int start = player1Turn ? 0 : PLAYER1_STORE + 1;
-    int end = player1Turn ? PLAYER1_STORE : TOTAL_PITS - 1;
-    
-    for (int i = start; i < end; i++) {
-        if (board[i] > 0) {
-            moves.push_back(i);
-        }
-    }
-    
-    return moves;
+template <class Board>
+std::vector<int> BasicMancalaGame<Board>::getPossibleMoves() const {
+    return board.getPossibleMoves();
 }
 
-MancalaGame* MancalaGame::clone() const {
-    MancalaGame* newGame = new MancalaGame();
-    
-    // Copy the board state
-    for (int i = 0; i < TOTAL_PITS; i++) {
-        newGame->board[i] = board[i];
-    }
+template <class Board>
+const Board& BasicMancalaGame<Board>::getBoard() const {
+    return board;
+}
+
+template <class Board>
+BasicMancalaGame<Board>* BasicMancalaGame<Board>::clone() const {
+    BasicMancalaGame* newGame = new BasicMancalaGame();
     
-    // Copy the turn state
-    newGame->player1Turn = player1Turn;
+    // Copy the board state, including whose turn it is
+    newGame->board = board;
+    newGame->finishAnimation();
     
     return newGame;
 }
 
-void MancalaGame::displayBoard(sf::RenderWindow& window, const sf::Font& font) {
+template <class Board>
+void BasicMancalaGame<Board>::displayBoard(sf::RenderWindow& window, const sf::Font& font) {
+    updateGeometry();
+    updateTexts(font);
+    
     // Clear the window
     window.clear(sf::Color(240, 240, 240));
     
-    // Draw all pits and stores
+    // Pits, stores and highlights in one draw call, then the texts on top
+    window.draw(geometry);
     for (int i = 0; i < TOTAL_PITS; i++) {
-        if (i == PLAYER1_STORE || i == PLAYER2_STORE) {
-            renderStore(window, i, font);
+        window.draw(stoneTexts[i]);
+    }
+    window.draw(playerLabels[0]);
+    window.draw(playerLabels[1]);
+    window.draw(turnText);
+    
+    // Stones on their way, over the counts they are heading for
+    if (isAnimating()) {
+        const Hop& hop = hops.front();
+        movingGeometry.clear();
+        
+        if (hop.from == hop.to) {
+            appendRing(movingGeometry, getCenter(hop.from), PIT_RADIUS, HIGHLIGHT_THICKNESS, PLAYED_PIT_COLOR);
         } else {
-            renderPit(window, i, font);
+            // Ease in and out between the two centers
+            float t = std::min(hopElapsed.asSeconds() / (stepTime.asSeconds() * hop.steps), 1.0f);
+            t = t * t * (3 - 2 * t);
+            sf::Vector2f from = getCenter(hop.from);
+            sf::Vector2f to = getCenter(hop.to);
+            sf::Vector2f position(from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t);
+            
+            // A handful of stones spiral around the position
+            for (int i = 0; i < hop.carried; i++) {
+                float distance = 2.5f * STONE_RADIUS * std::sqrt(static_cast<float>(i));
+                sf::Vector2f offset(distance * std::cos(i * 2.4f), distance * std::sin(i * 2.4f));
+                appendDisc(movingGeometry, position + offset, STONE_RADIUS, STONE_COLOR);
+            }
         }
+        window.draw(movingGeometry);
     }
     
-    // Draw turn indicator
-    renderTurnIndicator(window, font);
-    
-    // If game is over, show the winner
-    if (isGameOver()) {
-        renderGameOver(window, font);
+    // If game is over, show the winner once the last move has played out
+    if (isGameOver() && !isAnimating()) {
+        window.draw(gameOverText);
     }
 }
 
-int MancalaGame::getPitFromMousePosition(int x, int y) const {
-    // Check pits
+template <class Board>
+int BasicMancalaGame<Board>::getPitFromMousePosition(int x, int y) const {
+    // Check pits, outline included
+    float reach = PIT_RADIUS + OUTLINE_THICKNESS;
     for (int i = 0; i < TOTAL_PITS; i++) {
         if (i == PLAYER1_STORE || i == PLAYER2_STORE) {
             continue;  // Skip stores
         }
         
-        sf::FloatRect bounds = pitShapes[i].getGlobalBounds();
-        if (bounds.contains(x, y)) {
+        sf::Vector2f center = getPitCenter(i);
+        float dx = x - center.x;
+        float dy = y - center.y;
+        if (dx * dx + dy * dy <= reach * reach) {
             return i;
         }
     }
@@ -255,137 +241,223 @@ int MancalaGame::getPitFromMousePosition(int x, int y) const {
     return -1;  // No pit selected
 }
 
-void MancalaGame::renderPit(sf::RenderWindow& window, int pit, const sf::Font& font) {
-    // Draw the pit
-    window.draw(pitShapes[pit]);
-    
-    // Draw the number of stones
-    sf::Text text;
-    text.setFont(font);
-    text.setString(std::to_string(board[pit]));
-    text.setCharacterSize(20);
-    text.setFillColor(sf::Color::Black);
-    
-    // Center the text in the pit
-    sf::FloatRect bounds = pitShapes[pit].getGlobalBounds();
-    text.setPosition(
-        bounds.left + bounds.width / 2 - text.getLocalBounds().width / 2,
-        bounds.top + bounds.height / 2 - text.getLocalBounds().height / 2
-    );
-    
-    window.draw(text);
-    
-    // Highlight valid moves for the current player
-    if (isValidMove(pit)) {
-        sf::CircleShape highlight = pitShapes[pit];
-        highlight.setFillColor(sf::Color::Transparent);
-        highlight.setOutlineColor(sf::Color::Green);
-        highlight.setOutlineThickness(3.0f);
-        window.draw(highlight);
+template <class Board>
+void BasicMancalaGame<Board>::setStepTime(sf::Time time) {
+    stepTime = time;
+    if (stepTime == sf::Time::Zero) {
+        finishAnimation();
     }
 }
 
-void MancalaGame::renderStore(sf::RenderWindow& window, int store, const sf::Font& font) {
-    // Draw the store
-    int storeIndex = (store == PLAYER1_STORE) ? 0 : 1;
-    window.draw(storeShapes[storeIndex]);
-    
-    // Draw the number of stones
-    sf::Text text;
-    text.setFont(font);
-    text.setString(std::to_string(board[store]));
-    text.setCharacterSize(24);
-    text.setFillColor(sf::Color::Black);
-    
-    // Center the text in the store
-    sf::FloatRect bounds = storeShapes[storeIndex].getGlobalBounds();
-    text.setPosition(
-        bounds.left + bounds.width / 2 - text.getLocalBounds().width / 2,
-        bounds.top + bounds.height / 2 - text.getLocalBounds().height / 2
-    );
-    
-    window.draw(text);
-    
-    // Draw player labels
-    sf::Text label;
-    label.setFont(font);
-    label.setCharacterSize(16);
-    label.setFillColor(sf::Color::Black);
+template <class Board>
+void BasicMancalaGame<Board>::update(sf::Time elapsed) {
+    if (!isAnimating()) {
+        return;
+    }
     
-    if (store == PLAYER1_STORE) {
-        label.setString("Player 1");
-    } else {
-        label.setString("Player 2");
+    hopElapsed += std::min(elapsed, MAX_FRAME_TIME);
+    while (!hops.empty()) {
+        Hop& hop = hops.front();
+        if (!hop.started) {
+            animatedPits[hop.from] -= hop.removed;
+            hop.started = true;
+        }
+        
+        sf::Time duration = stepTime * hop.steps;
+        if (hopElapsed < duration) {
+            return;
+        }
+        hopElapsed -= duration;
+        animatedPits[hop.to] += hop.dropped;
+        hops.pop_front();
+    }
+    hopElapsed = sf::Time::Zero;
+}
+
+template <class Board>
+bool BasicMancalaGame<Board>::isAnimating() const {
+    return !hops.empty();
+}
+
+template <class Board>
+void BasicMancalaGame<Board>::finishAnimation() {
+    hops.clear();
+    hopElapsed = sf::Time::Zero;
+    for (int i = 0; i < TOTAL_PITS; i++) {
+        animatedPits[i] = board.pits[i];
+    }
+}
+
+template <class Board>
+void BasicMancalaGame<Board>::queueMove(const Board& before, const typename Board::Undo& undo) {
+    int side = before.isPlayer1Turn() ? 0 : 1;
+    int store = before.isPlayer1Turn() ? PLAYER1_STORE : PLAYER2_STORE;
+    
+    // Show the played pit, then pick up all of its stones and drop one in
+    // each pit along the sowing path
+    hops.push_back(Hop{undo.pit, undo.pit, 0, 0, 0, PAUSE_STEPS, false});
+    const int8_t* next = Board::tables.next[side];
+    int pit = undo.pit;
+    for (int sown = 0; sown < undo.stones; sown++) {
+        int removed = sown == 0 ? undo.stones : 0;
+        hops.push_back(Hop{pit, next[pit], removed, undo.stones - sown, 1, 1.0f, false});
+        pit = next[pit];
     }
     
-    label.setPosition(
-        bounds.left + bounds.width / 2 - label.getLocalBounds().width / 2,
-        bounds.top + bounds.height + 10
-    );
+    // The captured stones and the landing stone go to the mover's store
+    if (undo.capturePit >= 0) {
+        int landingPit = Board::getOpposingPit(undo.capturePit);
+        int captured = undo.capturedStones;
+        hops.push_back(Hop{undo.capturePit, store, captured, captured, captured, CAPTURE_STEPS, false});
+        hops.push_back(Hop{landingPit, store, 1, 1, 1, CAPTURE_STEPS, false});
+    }
     
-    window.draw(label);
+    // At the end of the game each side's remaining stones go to its own store
+    if (undo.swept) {
+        for (int i = 0; i < TOTAL_PITS; i++) {
+            int stones = undo.sweptPits[i];
+            if (i == PLAYER1_STORE || i == PLAYER2_STORE || stones == 0) {
+                continue;
+            }
+            int target = i < PLAYER1_STORE ? PLAYER1_STORE : PLAYER2_STORE;
+            hops.push_back(Hop{i, target, stones, stones, stones, SWEEP_STEPS, false});
+        }
+    }
 }
 
-void MancalaGame::renderTurnIndicator(sf::RenderWindow& window, const sf::Font& font) {
-    sf::Text text;
-    text.setFont(font);
-    text.setString(player1Turn ? "Player 1's Turn" : "Player 2's Turn");
-    text.setCharacterSize(24);
-    text.setFillColor(sf::Color::Black);
-    text.setPosition(BOARD_MARGIN_X, BOARD_MARGIN_Y + STORE_HEIGHT + 50);
-    
-    window.draw(text);
+template <class Board>
+void BasicMancalaGame<Board>::updateGeometry() {
+    // Highlight valid moves for the current player, once the moves so far
+    // have played out
+    int highlights = 0;
+    for (int i = 0; i < TOTAL_PITS && !isAnimating(); i++) {
+        if (isValidMove(i)) {
+            highlights |= 1 << i;
+        }
+    }
+    if (highlights == shownHighlights) {
+        return;
+    }
+    shownHighlights = highlights;
+    
+    // The whole board is a few thousand vertices, rebuilding it once per move is cheap
+    geometry.clear();
+    for (int store = 0; store < 2; store++) {
+        sf::FloatRect rect = getStoreRect(store == 0 ? PLAYER1_STORE : PLAYER2_STORE);
+        appendRect(geometry, rect, store == 0 ? PLAYER1_STORE_COLOR : PLAYER2_STORE_COLOR);
+        appendFrame(geometry, rect, OUTLINE_THICKNESS, sf::Color::Black);
+    }
+    for (int i = 0; i < TOTAL_PITS; i++) {
+        if (i == PLAYER1_STORE || i == PLAYER2_STORE) {
+            continue;
+        }
+        sf::Vector2f center = getPitCenter(i);
+        appendDisc(geometry, center, PIT_RADIUS, i < PLAYER1_STORE ? PLAYER1_PIT_COLOR : PLAYER2_PIT_COLOR);
+        appendRing(geometry, center, PIT_RADIUS, OUTLINE_THICKNESS, sf::Color::Black);
+        if (highlights & (1 << i)) {
+            appendRing(geometry, center, PIT_RADIUS, HIGHLIGHT_THICKNESS, sf::Color::Green);
+        }
+    }
 }
 
-void MancalaGame::renderGameOver(sf::RenderWindow& window, const sf::Font& font) {
-    int winner = getWinner();
-    
-    sf::Text text;
-    text.setFont(font);
+template <class Board>
+void BasicMancalaGame<Board>::updateTexts(const sf::Font& font) {
+    // Set up the fixed parts once per font
+    if (textFont != &font) {
+        textFont = &font;
+        for (int i = 0; i < TOTAL_PITS; i++) {
+            bool store = (i == PLAYER1_STORE || i == PLAYER2_STORE);
+            stoneTexts[i].setFont(font);
+            stoneTexts[i].setCharacterSize(store ? 24 : 20);
+            stoneTexts[i].setFillColor(sf::Color::Black);
+            shownStones[i] = -1;
+        }
+        
+        // Player labels under the stores
+        for (int player = 0; player < 2; player++) {
+            sf::FloatRect rect = getStoreRect(player == 0 ? PLAYER1_STORE : PLAYER2_STORE);
+            sf::Text& label = playerLabels[player];
+            label.setFont(font);
+            label.setCharacterSize(16);
+            label.setFillColor(sf::Color::Black);
+            label.setString(player == 0 ? "Player 1" : "Player 2");
+            label.setPosition(
+                rect.left + rect.width / 2 - label.getLocalBounds().width / 2,
+                rect.top + rect.height + OUTLINE_THICKNESS + 10
+            );
+        }
+        
+        turnText.setFont(font);
+        turnText.setCharacterSize(24);
+        turnText.setFillColor(sf::Color::Black);
+        turnText.setPosition(BOARD_MARGIN_X, BOARD_MARGIN_Y + STORE_HEIGHT + 50);
+        shownTurn = 0;
+        
+        gameOverText.setFont(font);
+        gameOverText.setCharacterSize(28);
+        gameOverText.setFillColor(sf::Color::Red);
+        gameOverText.setPosition(BOARD_MARGIN_X, BOARD_MARGIN_Y + STORE_HEIGHT + 90);
+        shownWinner = -1;
+    }
     
-    if (winner == 0) {
-        text.setString("Game Over! It's a tie!");
-    } else {
-        text.setString("Game Over! Player " + std::to_string(winner) + " wins!");
+    // Stone counts as far as the animation got, centered in their pit or store
+    for (int i = 0; i < TOTAL_PITS; i++) {
+        if (animatedPits[i] == shownStones[i]) {
+            continue;
+        }
+        shownStones[i] = animatedPits[i];
+        stoneTexts[i].setString(std::to_string(animatedPits[i]));
+        centerText(stoneTexts[i], getCenter(i));
     }
     
-    text.setCharacterSize(28);
-    text.setFillColor(sf::Color::Red);
-    text.setPosition(BOARD_MARGIN_X, BOARD_MARGIN_Y + STORE_HEIGHT + 90);
+    int turn = board.isPlayer1Turn() ? 1 : 2;
+    if (turn != shownTurn) {
+        shownTurn = turn;
+        turnText.setString(turn == 1 ? "Player 1's Turn" : "Player 2's Turn");
+    }
     
-    window.draw(text);
+    if (isGameOver() && getWinner() != shownWinner) {
+        shownWinner = getWinner();
+        if (shownWinner == 0) {
+            gameOverText.setString("Game Over! It's a tie!");
+        } else {
+            gameOverText.setString("Game Over! Player " + std::to_string(shownWinner) + " wins!");
+        }
+    }
 }
 
-int MancalaGame::getOpposingPit(int pit) const {
+template <class Board>
+sf::Vector2f BasicMancalaGame<Board>::getPitCenter(int pit) const {
+    // Player 1's pits run right to left along the bottom row, Player 2's
+    // left to right along the top row
+    float x, y;
     if (pit < PLAYER1_STORE) {
-        // Player 1's pit, return the opposing Player 2's pit
-        return TOTAL_PITS - 2 - pit;
-    } else if (pit > PLAYER1_STORE && pit < PLAYER2_STORE) {
-        // Player 2's pit, return the opposing Player 1's pit
-        return TOTAL_PITS - 2 - pit;
+        x = BOARD_MARGIN_X + (PITS_PER_PLAYER - 1 - pit) * PIT_SPACING;
+        y = BOARD_MARGIN_Y + PIT_SPACING;
+    } else {
+        x = BOARD_MARGIN_X + (pit - PLAYER1_STORE - 1) * PIT_SPACING;
+        y = BOARD_MARGIN_Y;
     }
-    
-    return -1;  // Not a regular pit
+    return sf::Vector2f(x + PIT_RADIUS, y + PIT_RADIUS);
 }
 
-bool MancalaGame::isOwnPit(int pit) const {
-    if (player1Turn) {
-        return pit < PLAYER1_STORE;
-    } else {
-        return pit > PLAYER1_STORE && pit < PLAYER2_STORE;
+template <class Board>
+sf::Vector2f BasicMancalaGame<Board>::getCenter(int pit) const {
+    if (pit == PLAYER1_STORE || pit == PLAYER2_STORE) {
+        sf::FloatRect rect = getStoreRect(pit);
+        return sf::Vector2f(rect.left + rect.width / 2, rect.top + rect.height / 2);
     }
+    return getPitCenter(pit);
 }
 
-void MancalaGame::collectRemainingStones() {
-    // Collect all stones from Player 1's side
-    for (int i = 0; i < PITS_PER_PLAYER; i++) {
-        board[PLAYER1_STORE] += board[i];
-        board[i] = 0;
-    }
-    
-    // Collect all stones from Player 2's side
-    for (int i = PLAYER1_STORE + 1; i < PLAYER2_STORE; i++) {
-        board[PLAYER2_STORE] += board[i];
-        board[i] = 0;
-    }
-}
\ No newline at end of file
+template <class Board>
+sf::FloatRect BasicMancalaGame<Board>::getStoreRect(int store) const {
+    // Player 1's store on the right, Player 2's on the left
+    float x = (store == PLAYER1_STORE) ? BOARD_MARGIN_X + PIT_SPACING * PITS_PER_PLAYER + 20
+                                       : BOARD_MARGIN_X - STORE_WIDTH - 20;
+    return sf::FloatRect(x, BOARD_MARGIN_Y, STORE_WIDTH, STORE_HEIGHT);
+}
+
+#define INSTANTIATE_GAME(PITS, STONES) template class BasicMancalaGame<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_GAME)
+#undef INSTANTIATE_GAME
@@ -2,21 +2,27 @@
 #define MANCALA_H
 
 #include <SFML/Graphics.hpp>
+#include <deque>
 #include <vector>
 #include <string>
+#include "board.h"
 
-class MancalaGame {
+// Game window side of one board variant: the board, its drawing and the
+// sowing animation. Board is the variant played, chosen at runtime with
+// withVariant (variant.h).
+template <class Board>
+class BasicMancalaGame {
 public:
     // Constants for the board
-    static const int PLAYER1_STORE = 6;
-    static const int PLAYER2_STORE = 13;
-    static const int TOTAL_PITS = 14;
-    static const int PITS_PER_PLAYER = 6;
-    static const int INITIAL_STONES = 4;
+    static const int PLAYER1_STORE = Board::PLAYER1_STORE;
+    static const int PLAYER2_STORE = Board::PLAYER2_STORE;
+    static const int TOTAL_PITS = Board::TOTAL_PITS;
+    static const int PITS_PER_PLAYER = Board::PITS_PER_PLAYER;
+    static const int INITIAL_STONES = Board::INITIAL_STONES;
 
     // Constructor and destructor
-    MancalaGame();
-    ~MancalaGame();
+    BasicMancalaGame();
+    ~BasicMancalaGame();
 
     // Game state methods
     bool isPlayer1Turn() const;
@@ -24,7 +30,8 @@ public:
     int getWinner() const; // 0 = tie, 1 = player1, 2 = player2
     int getScore(int player) const; // player 1 or 2
 
-    // Move validation and execution
+    // Move validation and execution. The board changes at once; the move is
+    // queued for the sowing animation, after any moves still playing back.
     bool isValidMove(int pit) const;
     bool makeMove(int pit);
     
@@ -32,37 +39,82 @@ public:
     int getStonesInPit(int pit) const;
     std::vector<int> getPossibleMoves() const;
     
+    // Headless state used by the AI and tools
+    const Board& getBoard() const;
+    
     // Clone the game for AI simulation
-    MancalaGame* clone() const;
+    BasicMancalaGame* clone() const;
     
     // GUI-related methods
     void displayBoard(sf::RenderWindow& window, const sf::Font& font);
     int getPitFromMousePosition(int x, int y) const;
     
-    // Helper methods for rendering
-    void renderPit(sf::RenderWindow& window, int pit, const sf::Font& font);
-    void renderStore(sf::RenderWindow& window, int store, const sf::Font& font);
-    void renderTurnIndicator(sf::RenderWindow& window, const sf::Font& font);
-    void renderGameOver(sf::RenderWindow& window, const sf::Font& font);
+    // Sowing animation: the stones of each move travel pit to pit, then
+    // captures and the final sweep fly to the stores. The displayed counts
+    // follow the animation, not the board, until it has caught up.
+    void setStepTime(sf::Time time);  // Time per pit travelled; zero shows moves at once
+    void update(sf::Time elapsed);    // Advance by the time since the last frame
+    bool isAnimating() const;
+    void finishAnimation();           // Skip to the current board
 
 private:
-    int board[TOTAL_PITS];
-    bool player1Turn;
+    // One leg of the animation: stones travelling from one pit or store to
+    // another. A leg from a pit to itself is the pause that shows the move.
+    struct Hop {
+        int from;
+        int to;
+        int removed;   // Taken out of from as the leg starts
+        int carried;   // Drawn travelling
+        int dropped;   // Put into to as the leg ends
+        float steps;   // Duration in step times
+        bool started;
+    };
+    
+    // Queue the legs of a move, made on a board that was in the state before it
+    void queueMove(const Board& before, const typename Board::Undo& undo);
+    
+    // Pit or store center, where travelling stones start and land
+    sf::Vector2f getCenter(int pit) const;
+    
+    // Bring the cached texts and geometry up to date with the board; only
+    // what changed since the last draw is touched
+    void updateTexts(const sf::Font& font);
+    void updateGeometry();
     
-    // Helper methods for game logic
-    int getOpposingPit(int pit) const;
-    bool isOwnPit(int pit) const;
-    void collectRemainingStones();
+    // Board layout
+    sf::Vector2f getPitCenter(int pit) const;
+    sf::FloatRect getStoreRect(int store) const;
+    
+    Board board;
     
     // GUI-related variables
-    sf::CircleShape pitShapes[TOTAL_PITS];
-    sf::RectangleShape storeShapes[2];
-    const float PIT_RADIUS = 40.0f;
-    const float STORE_WIDTH = 60.0f;
-    const float STORE_HEIGHT = 180.0f;
-    const float BOARD_MARGIN_X = 100.0f;
-    const float BOARD_MARGIN_Y = 150.0f;
-    const float PIT_SPACING = 100.0f;
+    sf::VertexArray geometry;         // Pits, stores and highlight rings, drawn in one call
+    int shownHighlights;              // Valid moves (bit per pit) the geometry shows, -1 before the first draw
+    sf::Text stoneTexts[TOTAL_PITS];
+    int shownStones[TOTAL_PITS];      // Count each text shows, -1 before the first draw
+    sf::Text playerLabels[2];
+    sf::Text turnText;
+    int shownTurn;                    // Player the turn text names, 0 before the first draw
+    sf::Text gameOverText;
+    int shownWinner;                  // Winner the game over text names, -1 before the game ends
+    const sf::Font* textFont;         // Font the texts were set up with
+    
+    // Animation state
+    std::deque<Hop> hops;
+    sf::Time hopElapsed;              // Time spent in the first leg
+    sf::Time stepTime;
+    int animatedPits[TOTAL_PITS];     // Counts shown while animating, the board's once caught up
+    sf::VertexArray movingGeometry;   // Travelling stones and the played pit's ring, rebuilt each frame
+    
+    static constexpr float PIT_RADIUS = 40.0f;
+    static constexpr float STORE_WIDTH = 60.0f;
+    static constexpr float STORE_HEIGHT = 180.0f;
+    static constexpr float PIT_SPACING = 100.0f;
+    static constexpr float BOARD_MARGIN_X = 400.0f - PIT_SPACING * PITS_PER_PLAYER / 2;  // Centered in the window
+    static constexpr float BOARD_MARGIN_Y = 150.0f;
 };
 
+// The standard game: six pits per side, four stones each
+typedef BasicMancalaGame<MancalaBoard> MancalaGame;
+
 #endif // MANCALA_H
\ No newline at end of file
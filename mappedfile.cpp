@@ -0,0 +1,109 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : mapping(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (fileMapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(fileMapping);
+        CloseHandle(file);
+        return false;
+    }
+    
+    fileHandle = file;
+    mappingHandle = fileMapping;
+    mapping = static_cast<const uint8_t*>(view);
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapping != nullptr) {
+        UnmapViewOfFile(mapping);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    mapping = nullptr;
+    length = 0;
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : mapping(nullptr), length(0) {
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    
+    mapping = static_cast<const uint8_t*>(view);
+    length = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapping != nullptr) {
+        munmap(const_cast<uint8_t*>(mapping), length);
+    }
+    mapping = nullptr;
+    length = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
@@ -0,0 +1,36 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file. Used for the precomputed
+// endgame tablebase and opening book, so their pages are shared with the
+// OS file cache and loaded on first touch instead of read in full at startup.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    // Map the file; returns false (and stays closed) if it cannot be opened
+    bool open(const std::string& path);
+    void close();
+    
+    bool isOpen() const { return mapping != nullptr; }
+    const uint8_t* data() const { return mapping; }
+    size_t size() const { return length; }
+    
+private:
+    const uint8_t* mapping;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,328 @@
+#include "mcts.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+template <class Board>
+const double BasicMCTSEngine<Board>::EXPLORATION = 1.0;
+
+template <class Board>
+BasicMCTSEngine<Board>::BasicMCTSEngine(int difficulty)
+    : threadCount(1), poolCapacity(0), poolUsed(0), hasDeadline(false), stopped(false),
+      stopRequested(false), playouts(0), maxDepth(0) {
+    setDifficulty(difficulty);
+    setPoolSize(32);
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::setDifficulty(int diff) {
+    difficulty = std::max(1, std::min(5, diff));  // Clamp between 1-5
+    
+    // Each level plays out four times as many games as the one below
+    switch (difficulty) {
+        case 1: playoutLimit = 250; break;
+        case 2: playoutLimit = 1000; break;
+        case 3: playoutLimit = 4000; break;
+        case 4: playoutLimit = 16000; break;
+        case 5: playoutLimit = 64000; break;
+        default: playoutLimit = 1000;
+    }
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::setPlayouts(uint64_t count) {
+    playoutLimit = std::max<uint64_t>(1, count);
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::setThreads(int count) {
+    threadCount = std::max(1, count);
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::setPoolSize(size_t megabytes) {
+    size_t capacity = std::max<size_t>(1, megabytes * 1024 * 1024 / sizeof(Node));
+    capacity = std::min<size_t>(capacity, std::numeric_limits<int32_t>::max());
+    
+    // The arena itself is allocated by the first search
+    if (capacity != poolCapacity) {
+        poolCapacity = capacity;
+        nodes.reset();
+    }
+}
+
+template <class Board>
+int BasicMCTSEngine<Board>::findBestMove(const Board& board) {
+    hasDeadline = false;
+    return startSearch(board, playoutLimit);
+}
+
+template <class Board>
+int BasicMCTSEngine<Board>::findBestMove(const Board& board, std::chrono::milliseconds budget) {
+    hasDeadline = true;
+    deadline = std::chrono::steady_clock::now() + budget;
+    return startSearch(board, std::numeric_limits<uint64_t>::max());
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::stop() {
+    stopRequested = true;
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::resetStop() {
+    stopRequested = false;
+}
+
+template <class Board>
+int BasicMCTSEngine<Board>::getLastSearchDepth() const {
+    return maxDepth.load();
+}
+
+template <class Board>
+uint64_t BasicMCTSEngine<Board>::getLastSearchNodes() const {
+    return playouts.load();
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::initNode(Node& node, int move, bool moverIsPlayer1) {
+    node.visits.store(0, std::memory_order_relaxed);
+    node.halfPoints.store(0, std::memory_order_relaxed);
+    node.firstChild.store(UNEXPANDED, std::memory_order_relaxed);
+    node.move = static_cast<int8_t>(move);
+    node.childCount = 0;
+    node.moverIsPlayer1 = moverIsPlayer1;
+}
+
+template <class Board>
+int BasicMCTSEngine<Board>::startSearch(const Board& board, uint64_t playoutBudget) {
+    stopped = false;
+    playouts = 0;
+    maxDepth = 0;
+    
+    int possibleMoves[Board::PITS_PER_PLAYER];
+    int moveCount = board.getPossibleMoves(possibleMoves);
+    
+    if (moveCount == 0) {
+        return -1;  // No valid moves
+    }
+    
+    // Nothing to think about with a single legal move under a time limit
+    if (moveCount == 1 && hasDeadline) {
+        return possibleMoves[0];
+    }
+    
+    if (!nodes) {
+        nodes.reset(new Node[poolCapacity]);
+    }
+    
+    // Every search starts a new tree at the front of the arena
+    poolUsed = 1;
+    Node& root = nodes[0];
+    initNode(root, -1, !board.isPlayer1Turn());
+    expand(root, board);
+    
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < threadCount; i++) {
+        uint32_t seed = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+        helpers.emplace_back([this, &board, playoutBudget, seed]() {
+            searchThread(board, playoutBudget, seed);
+        });
+    }
+    
+    searchThread(board, playoutBudget, 0x9E3779B9u);
+    
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+    
+    // The most visited move is the most reliable one
+    int bestMove = possibleMoves[0];
+    int32_t first = root.firstChild.load(std::memory_order_acquire);
+    if (first >= 0) {
+        int32_t bestVisits = 0;
+        for (int i = 0; i < root.childCount; i++) {
+            const Node& child = nodes[first + i];
+            int32_t visits = child.visits.load(std::memory_order_relaxed);
+            if (visits > bestVisits) {
+                bestVisits = visits;
+                bestMove = child.move;
+            }
+        }
+    }
+    
+    return bestMove;
+}
+
+template <class Board>
+void BasicMCTSEngine<Board>::searchThread(const Board& root, uint64_t playoutBudget, uint32_t seed) {
+    uint32_t random = seed;
+    std::vector<Node*> path;
+    int deepest = 0;
+    
+    for (;;) {
+        if (stopped.load(std::memory_order_relaxed)) {
+            break;
+        }
+        if (stopRequested.load(std::memory_order_relaxed)) {
+            stopped = true;
+            break;
+        }
+        
+        // Claim the next playout of the budget
+        uint64_t index = playouts.fetch_add(1, std::memory_order_relaxed);
+        if (index >= playoutBudget) {
+            playouts.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+        
+        // Looking at the clock is comparatively slow, so only do it every few dozen playouts
+        if (hasDeadline && (index & TIME_CHECK_INTERVAL) == 0 &&
+            std::chrono::steady_clock::now() >= deadline) {
+            playouts.fetch_sub(1, std::memory_order_relaxed);
+            stopped = true;
+            break;
+        }
+        
+        // Selection: follow UCT down to a node without children, expand it
+        // and step into one of the new children
+        Board board = root;
+        Node* node = &nodes[0];
+        node->visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+        path.clear();
+        path.push_back(node);
+        
+        bool expanded = false;
+        while (!board.isGameOver()) {
+            int32_t first = node->firstChild.load(std::memory_order_acquire);
+            if (first == UNEXPANDED && !expanded) {
+                expanded = expand(*node, board);
+                first = node->firstChild.load(std::memory_order_acquire);
+            }
+            if (first < 0) {
+                break;  // Being expanded by another thread, or the arena is full
+            }
+            
+            node = &selectChild(*node);
+            node->visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+            path.push_back(node);
+            
+            typename Board::Undo undo;
+            board.makeMove(node->move, undo);
+            
+            if (expanded) {
+                break;
+            }
+        }
+        
+        deepest = std::max(deepest, static_cast<int>(path.size()) - 1);
+        
+        // Simulation and backpropagation, replacing the virtual losses
+        int winner = playout(board, random);
+        for (Node* visited : path) {
+            int32_t points = winner == 0 ? 1 : (winner == 1) == visited->moverIsPlayer1 ? 2 : 0;
+            visited->halfPoints.fetch_add(points, std::memory_order_relaxed);
+            visited->visits.fetch_add(1 - VIRTUAL_LOSS, std::memory_order_relaxed);
+        }
+    }
+    
+    int previous = maxDepth.load();
+    while (deepest > previous && !maxDepth.compare_exchange_weak(previous, deepest)) {
+    }
+}
+
+template <class Board>
+bool BasicMCTSEngine<Board>::expand(Node& node, const Board& board) {
+    int32_t expected = UNEXPANDED;
+    if (!node.firstChild.compare_exchange_strong(expected, EXPANDING)) {
+        return false;
+    }
+    
+    int possibleMoves[Board::PITS_PER_PLAYER];
+    int moveCount = board.getPossibleMoves(possibleMoves);
+    
+    // A full arena leaves the node marked as expanding for good, so it
+    // stays a leaf and nobody tries again
+    size_t first = poolUsed.fetch_add(moveCount);
+    if (first + moveCount > poolCapacity) {
+        return false;
+    }
+    
+    for (int i = 0; i < moveCount; i++) {
+        initNode(nodes[first + i], possibleMoves[i], board.isPlayer1Turn());
+    }
+    
+    // Publishing the index makes the children visible to the other threads
+    node.childCount = static_cast<uint8_t>(moveCount);
+    node.firstChild.store(static_cast<int32_t>(first), std::memory_order_release);
+    return true;
+}
+
+template <class Board>
+typename BasicMCTSEngine<Board>::Node& BasicMCTSEngine<Board>::selectChild(Node& parent) {
+    int32_t first = parent.firstChild.load(std::memory_order_acquire);
+    int32_t parentVisits = parent.visits.load(std::memory_order_relaxed);
+    double logParent = std::log(static_cast<double>(std::max(1, parentVisits)));
+    
+    Node* best = &nodes[first];
+    double bestValue = -std::numeric_limits<double>::infinity();
+    
+    for (int i = 0; i < parent.childCount; i++) {
+        Node& child = nodes[first + i];
+        int32_t visits = child.visits.load(std::memory_order_relaxed);
+        
+        // Unvisited children are tried first
+        if (visits == 0) {
+            return child;
+        }
+        
+        // A virtual loss counts as a visit without points, so children
+        // other threads are busy with look worse until they return
+        double winRate = child.halfPoints.load(std::memory_order_relaxed) / (2.0 * visits);
+        double value = winRate + EXPLORATION * std::sqrt(logParent / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = &child;
+        }
+    }
+    
+    return *best;
+}
+
+template <class Board>
+int BasicMCTSEngine<Board>::playout(Board board, uint32_t& random) {
+    while (!board.isGameOver()) {
+        int possibleMoves[Board::PITS_PER_PLAYER];
+        int moveCount = board.getPossibleMoves(possibleMoves);
+        
+        // Take an extra turn when there is one, starting with the pit next
+        // to the store so the others still reach it afterwards
+        int store = board.isPlayer1Turn() ? Board::PLAYER1_STORE : Board::PLAYER2_STORE;
+        int move = -1;
+        for (int i = moveCount - 1; i >= 0; i--) {
+            if (board.pits[possibleMoves[i]] == store - possibleMoves[i]) {
+                move = possibleMoves[i];
+                break;
+            }
+        }
+        
+        // Otherwise play a random move (xorshift32)
+        if (move < 0) {
+            random ^= random << 13;
+            random ^= random >> 17;
+            random ^= random << 5;
+            move = possibleMoves[random % moveCount];
+        }
+        
+        typename Board::Undo undo;
+        board.makeMove(move, undo);
+    }
+    
+    return board.getWinner();
+}
+
+#define INSTANTIATE_MCTS(PITS, STONES) template class BasicMCTSEngine<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_MCTS)
+#undef INSTANTIATE_MCTS
@@ -0,0 +1,115 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "board.h"
+#include "engine.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Monte Carlo Tree Search (UCT) engine, an alternative to MancalaAI's
+// alpha-beta. Every iteration walks down the tree by the UCT formula,
+// expands one leaf and plays the game out with a light policy (take an
+// extra turn when one is available, otherwise a random move).
+//
+// Tree nodes come from an arena allocated once and reused by every search.
+// With several threads all of them grow the same tree (tree parallelism);
+// a thread walking through a node adds a virtual loss to it so the others
+// spread out over different lines.
+template <class Board>
+class BasicMCTSEngine : public BasicEngine<Board> {
+public:
+    // Constructor with difficulty level (affects the playout budget)
+    BasicMCTSEngine(int difficulty = 2);
+    
+    // Play out the playout budget set by the difficulty or setPlayouts
+    int findBestMove(const Board& board) override;
+    
+    // Play out until the wall-clock budget runs out
+    int findBestMove(const Board& board, std::chrono::milliseconds budget) override;
+    
+    // Same contract as MancalaAI::stop: the search returns the most visited
+    // move so far, or the first legal one
+    void stop() override;
+    void resetStop() override;
+    
+    void setDifficulty(int difficulty) override;
+    void setThreads(int count) override;
+    
+    // Fixed number of playouts per search instead of the difficulty's
+    void setPlayouts(uint64_t playouts);
+    
+    // Memory budget of the node arena in megabytes. Once it is full the
+    // tree stops growing and further playouts start from its leaves.
+    void setPoolSize(size_t megabytes);
+    
+    // Deepest tree node reached by the last search
+    int getLastSearchDepth() const override;
+    
+    // Playouts run by all threads during the last search
+    uint64_t getLastSearchNodes() const override;
+
+private:
+    // UCT exploration constant, for results scored 0 (loss) to 1 (win)
+    static const double EXPLORATION;
+    
+    // Visits a thread adds to each node on its path until its playout is back
+    static const int VIRTUAL_LOSS = 3;
+    
+    // The clock is read once every TIME_CHECK_INTERVAL + 1 playouts
+    static const uint64_t TIME_CHECK_INTERVAL = 63;
+    
+    static const int32_t UNEXPANDED = -1;
+    static const int32_t EXPANDING = -2;
+    
+    // Results are stored in half points for the player who made the move
+    // leading to the node: 2 for a win, 1 for a draw, 0 for a loss
+    struct Node {
+        std::atomic<int32_t> visits;
+        std::atomic<int32_t> halfPoints;
+        std::atomic<int32_t> firstChild;  // Arena index, UNEXPANDED or EXPANDING
+        int8_t move;                      // Pit played to reach this node
+        uint8_t childCount;               // Valid once firstChild is an index
+        bool moverIsPlayer1;
+    };
+    
+    int difficulty;
+    uint64_t playoutLimit;
+    int threadCount;
+    
+    std::unique_ptr<Node[]> nodes;
+    size_t poolCapacity;
+    std::atomic<size_t> poolUsed;
+    
+    // Per-search state shared by all threads
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+    std::atomic<bool> stopped;
+    std::atomic<bool> stopRequested;  // Set by stop(), only cleared by resetStop()
+    std::atomic<uint64_t> playouts;
+    std::atomic<int> maxDepth;
+    
+    // Run a search with all threads and return the most visited root move
+    int startSearch(const Board& board, uint64_t playoutBudget);
+    
+    // One thread's search loop
+    void searchThread(const Board& root, uint64_t playoutBudget, uint32_t seed);
+    
+    // Allocate the children of node for the moves of board. Returns false if
+    // another thread is expanding it or the arena is full.
+    bool expand(Node& node, const Board& board);
+    
+    // Child of parent with the highest UCT value
+    Node& selectChild(Node& parent);
+    
+    // Play board out to the end and return the winner as in getWinner
+    static int playout(Board board, uint32_t& random);
+    
+    void initNode(Node& node, int move, bool moverIsPlayer1);
+};
+
+typedef BasicMCTSEngine<MancalaBoard> MCTSEngine;
+
+#endif // MCTS_H
@@ -0,0 +1,180 @@
+// Micro-benchmarks for the hot rules-engine and evaluation calls, timed
+// with a small built-in harness: each call runs over a fixed set of
+// mid-game positions until at least MIN_SECONDS have passed, and the
+// average time per call is reported. Evaluation is also timed over the
+// same positions in boards per second, one at a time and batched.
+//
+// Usage: microbench
+
+#include "ai.h"
+#include "board.h"
+#include "boardbatch.h"
+#include "zobrist.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    const double MIN_SECONDS = 0.25;
+    const size_t POSITION_COUNT = 4096;
+    
+    struct Sample {
+        MancalaBoard board;
+        int move;  // A legal move in board
+    };
+    
+    // Positions from random playouts with a fixed seed, each with a random legal move
+    std::vector<Sample> samplePositions() {
+        std::mt19937 rng(12345);
+        std::vector<Sample> samples;
+        
+        while (samples.size() < POSITION_COUNT) {
+            MancalaBoard board;
+            board.reset();
+            int plies = static_cast<int>(rng() % 40);
+            for (int ply = 0; ply < plies && !board.isGameOver(); ply++) {
+                int moves[MancalaBoard::PITS_PER_PLAYER];
+                int moveCount = board.getPossibleMoves(moves);
+                board.makeMove(moves[rng() % moveCount]);
+            }
+            if (board.isGameOver()) {
+                continue;
+            }
+            
+            int moves[MancalaBoard::PITS_PER_PLAYER];
+            int moveCount = board.getPossibleMoves(moves);
+            Sample sample = { board, moves[rng() % moveCount] };
+            samples.push_back(sample);
+        }
+        
+        return samples;
+    }
+    
+    // Results are summed into here so the calls cannot be optimized away
+    volatile uint64_t sink;
+    
+    template <typename Call>
+    void run(const char* name, std::vector<Sample>& samples, Call call) {
+        uint64_t total = 0;
+        uint64_t calls = 0;
+        double seconds = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        
+        do {
+            for (Sample& sample : samples) {
+                total += call(sample);
+            }
+            calls += samples.size();
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (seconds < MIN_SECONDS);
+        
+        sink = sink + total;
+        std::printf("%-22s %8.2f ns/call %10.1f M calls/s\n", name, 1e9 * seconds / calls, calls / seconds / 1e6);
+    }
+    
+    // Like run, for a call that evaluates every position at once; returns boards per second
+    template <typename Call>
+    double runBoards(const char* name, size_t boardCount, Call call) {
+        uint64_t total = 0;
+        uint64_t boards = 0;
+        double seconds = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        
+        do {
+            total += call();
+            boards += boardCount;
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (seconds < MIN_SECONDS);
+        
+        sink = sink + total;
+        double boardsPerSecond = boards / seconds;
+        std::printf("%-22s %8.2f ns/board %9.1f M boards/s\n", name, 1e9 * seconds / boards, boardsPerSecond / 1e6);
+        return boardsPerSecond;
+    }
+}
+
+int main() {
+#ifdef MANCALA_SWAR_BOARD
+    std::printf("board: swar\n");
+#else
+    std::printf("board: scalar\n");
+#endif
+    
+    std::vector<Sample> samples = samplePositions();
+    MancalaAI ai;
+    std::vector<MancalaBoard> copies(samples.size());
+    size_t copyIndex = 0;
+    
+    run("clone (board copy)", samples, [&](Sample& sample) {
+        MancalaBoard& copy = copies[copyIndex++ % copies.size()];
+        copy = sample.board;
+        return copy.pits[sample.move];
+    });
+    
+    run("makeMove (copy)", samples, [](Sample& sample) {
+        MancalaBoard board = sample.board;
+        board.makeMove(sample.move);
+        return board.pits[MancalaBoard::PLAYER1_STORE] + board.pits[MancalaBoard::PLAYER2_STORE];
+    });
+    
+    run("makeMove + unmakeMove", samples, [](Sample& sample) {
+        MoveUndo undo;
+        sample.board.makeMove(sample.move, undo);
+        int stores = sample.board.pits[MancalaBoard::PLAYER1_STORE];
+        sample.board.unmakeMove(undo);
+        return stores;
+    });
+    
+    run("makeMove hashed", samples, [](Sample& sample) {
+        uint64_t hash = 0;
+        MoveUndo undo;
+        sample.board.makeMove(sample.move, undo, hash);
+        sample.board.unmakeMove(undo, hash);
+        return hash;
+    });
+    
+    run("getPossibleMoves", samples, [](Sample& sample) {
+        int moves[MancalaBoard::PITS_PER_PLAYER];
+        return sample.board.getPossibleMoves(moves);
+    });
+    
+    run("isGameOver", samples, [](Sample& sample) {
+        return sample.board.isGameOver() ? 1 : 0;
+    });
+    
+    run("evaluateBoard", samples, [&](Sample& sample) {
+        return ai.evaluateBoard(sample.board);
+    });
+    
+    run("Zobrist::hash", samples, [](Sample& sample) {
+        return Zobrist::hash(sample.board);
+    });
+    
+    BoardBatch batch;
+    batch.reserve(samples.size());
+    for (const Sample& sample : samples) {
+        batch.add(sample.board);
+    }
+    std::vector<int> scores(samples.size());
+    
+    std::printf("\n");
+    double scalar = runBoards("evaluateBoard", samples.size(), [&]() {
+        uint64_t total = 0;
+        for (const Sample& sample : samples) {
+            total += ai.evaluateBoard(sample.board);
+        }
+        return total;
+    });
+    double batched = runBoards("evaluateBatch", samples.size(), [&]() {
+        ai.evaluateBatch(batch, scores.data());
+        uint64_t total = 0;
+        for (int score : scores) {
+            total += score;
+        }
+        return total;
+    });
+    std::printf("batch speedup          %8.2fx\n", batched / scalar);
+    
+    return 0;
+}
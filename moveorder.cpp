@@ -0,0 +1,175 @@
+#include "moveorder.h"
+
+namespace {
+    // Ordering tiers; each tier outranks every score of the tiers below it
+    const int TT_MOVE_SCORE = 1 << 30;
+    const int EXTRA_TURN_SCORE = 1 << 29;
+    const int CAPTURE_SCORE = 1 << 28;
+    const int KILLER_SCORE = 1 << 27;
+    
+    // Sowing skips the opponent's store, so a lap has TOTAL_PITS - 1 pits
+    template <class Board>
+    int lap() {
+        return Board::TOTAL_PITS - 1;
+    }
+    
+    template <class Board>
+    int ownStore(const Board& board) {
+        return board.isPlayer1Turn() ? Board::PLAYER1_STORE : Board::PLAYER2_STORE;
+    }
+    
+    // Steps along the sowing path from pit to target
+    template <class Board>
+    int distance(int pit, int target) {
+        return (target - pit + Board::TOTAL_PITS) % Board::TOTAL_PITS;
+    }
+}
+
+template <class Board>
+BasicMoveOrdering<Board>::BasicMoveOrdering() {
+    clear();
+}
+
+template <class Board>
+void BasicMoveOrdering<Board>::clear() {
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = -1;
+        killers[ply][1] = -1;
+    }
+    for (int side = 0; side < 2; side++) {
+        for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+            history[side][pit] = 0;
+        }
+    }
+}
+
+template <class Board>
+void BasicMoveOrdering<Board>::age() {
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = -1;
+        killers[ply][1] = -1;
+    }
+    for (int side = 0; side < 2; side++) {
+        for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+            history[side][pit] /= 2;
+        }
+    }
+}
+
+template <class Board>
+bool BasicMoveOrdering<Board>::isExtraTurn(const Board& board, int pit) {
+    // The own store is never skipped, so full laps come back to the same spot
+    return board.pits[pit] % lap<Board>() == distance<Board>(pit, ownStore(board));
+}
+
+template <class Board>
+int BasicMoveOrdering<Board>::captureSize(const Board& board, int pit) {
+    int stones = board.pits[pit];
+    
+    // More than one lap drops at least two stones into the landing pit
+    if (stones > lap<Board>()) {
+        return 0;
+    }
+    
+    // Find the landing pit, stepping over the opponent's store if it is passed
+    int opponentStore = board.isPlayer1Turn() ? Board::PLAYER2_STORE : Board::PLAYER1_STORE;
+    int steps = stones;
+    if (distance<Board>(pit, opponentStore) <= steps) {
+        steps++;
+    }
+    int landing = (pit + steps) % Board::TOTAL_PITS;
+    
+    // A full lap lands back in the emptied starting pit
+    bool landsInEmptyPit = (stones == lap<Board>()) || board.pits[landing] == 0;
+    if (!landsInEmptyPit || !board.isOwnPit(landing) || landing == ownStore(board)) {
+        return 0;
+    }
+    
+    // The opposing pit also gets a stone if the sowing passed it
+    int opposingPit = Board::getOpposingPit(landing);
+    int opposingStones = board.pits[opposingPit];
+    if (distance<Board>(pit, opposingPit) <= steps && opposingPit != pit) {
+        opposingStones++;
+    }
+    
+    return opposingStones > 0 ? opposingStones + 1 : 0;
+}
+
+template <class Board>
+int BasicMoveOrdering<Board>::scoreMove(const Board& board, int move, int ttMove, int ply) const {
+    if (move == ttMove) {
+        return TT_MOVE_SCORE;
+    }
+    
+    // Extra turns nearest the store first, they disturb the other pits least
+    if (isExtraTurn(board, move)) {
+        return EXTRA_TURN_SCORE - distance<Board>(move, ownStore(board));
+    }
+    
+    int captured = captureSize(board, move);
+    if (captured > 0) {
+        return CAPTURE_SCORE + captured;
+    }
+    
+    if (ply < MAX_PLY) {
+        if (move == killers[ply][0]) {
+            return KILLER_SCORE + 1;
+        }
+        if (move == killers[ply][1]) {
+            return KILLER_SCORE;
+        }
+    }
+    
+    return history[board.isPlayer1Turn() ? 0 : 1][move];
+}
+
+template <class Board>
+void BasicMoveOrdering<Board>::orderMoves(const Board& board, int moves[], int count, int ttMove, int ply) const {
+    int scores[Board::PITS_PER_PLAYER];
+    for (int i = 0; i < count; i++) {
+        scores[i] = scoreMove(board, moves[i], ttMove, ply);
+    }
+    
+    // Insertion sort, there are at most PITS_PER_PLAYER moves
+    for (int i = 1; i < count; i++) {
+        int move = moves[i];
+        int score = scores[i];
+        int j = i - 1;
+        while (j >= 0 && scores[j] < score) {
+            moves[j + 1] = moves[j];
+            scores[j + 1] = scores[j];
+            j--;
+        }
+        moves[j + 1] = move;
+        scores[j + 1] = score;
+    }
+}
+
+template <class Board>
+void BasicMoveOrdering<Board>::recordCutoff(const Board& board, int move, int ply, int depth) {
+    // Tactical moves are already ordered early, only quiet moves are remembered
+    if (isExtraTurn(board, move) || captureSize(board, move) > 0) {
+        return;
+    }
+    
+    if (ply < MAX_PLY && killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+    
+    int side = board.isPlayer1Turn() ? 0 : 1;
+    history[side][move] += depth * depth;
+    
+    // Keep history below the killer tier and let old results fade
+    if (history[side][move] > HISTORY_LIMIT) {
+        for (int s = 0; s < 2; s++) {
+            for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+                history[s][pit] /= 2;
+            }
+        }
+    }
+}
+
+#define INSTANTIATE_ORDERING(PITS, STONES) template class BasicMoveOrdering<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_ORDERING)
+#undef INSTANTIATE_ORDERING
@@ -0,0 +1,49 @@
+#ifndef MOVEORDER_H
+#define MOVEORDER_H
+
+#include "board.h"
+
+// Orders moves for the alpha-beta search so that cutoffs come early:
+// 1. the transposition table / principal variation move
+// 2. moves whose last stone lands in the store (extra turn), nearest the store first
+// 3. captures, largest capture first
+// 4. the two killer moves of this ply
+// 5. everything else by history score
+template <class Board>
+class BasicMoveOrdering {
+public:
+    // Deepest ply (sowings from the root) that keeps killer moves
+    static const int MAX_PLY = 128;
+    
+    BasicMoveOrdering();
+    
+    // Forget killers and history
+    void clear();
+    
+    // Carry the history over to the next search at half weight. Killers are
+    // dropped: the root moves on, so their plies no longer line up.
+    void age();
+    
+    // Sort moves in place, best candidates first. ttMove may be -1.
+    void orderMoves(const Board& board, int moves[], int count, int ttMove, int ply) const;
+    
+    // Record a move that caused a beta cutoff at the given ply and remaining depth
+    void recordCutoff(const Board& board, int move, int ply, int depth);
+    
+    // Whether the move earns an extra turn or captures
+    static bool isExtraTurn(const Board& board, int pit);
+    static int captureSize(const Board& board, int pit);  // 0 if no capture
+    
+private:
+    // History scores are halved once any of them passes this value
+    static const int HISTORY_LIMIT = 1 << 16;
+    
+    int killers[MAX_PLY][2];
+    int history[2][Board::TOTAL_PITS];  // [Player 1 / Player 2][pit]
+    
+    int scoreMove(const Board& board, int move, int ttMove, int ply) const;
+};
+
+typedef BasicMoveOrdering<MancalaBoard> MoveOrdering;
+
+#endif // MOVEORDER_H
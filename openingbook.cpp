@@ -0,0 +1,70 @@
+#include "openingbook.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const char MAGIC[8] = { 'M', 'N', 'C', 'L', 'B', 'O', 'O', 'K' };
+}
+
+OpeningBook::OpeningBook() : keys(nullptr), moves(nullptr), entryCount(0) {
+}
+
+bool OpeningBook::open(const std::string& path) {
+    close();
+    
+    if (!file.open(path)) {
+        return false;
+    }
+    
+    Header header;
+    if (file.size() < sizeof(Header)) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(Header));
+    
+    uint64_t expectedSize = sizeof(Header) + header.entryCount * (sizeof(uint64_t) + sizeof(Move));
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header.version == VERSION &&
+                 file.size() == expectedSize;
+    if (!valid) {
+        file.close();
+        return false;
+    }
+    
+    // The header is 24 bytes, so the key array stays 8-byte aligned
+    keys = reinterpret_cast<const uint64_t*>(file.data() + sizeof(Header));
+    moves = reinterpret_cast<const Move*>(keys + header.entryCount);
+    entryCount = static_cast<size_t>(header.entryCount);
+    return true;
+}
+
+void OpeningBook::close() {
+    file.close();
+    keys = nullptr;
+    moves = nullptr;
+    entryCount = 0;
+}
+
+int OpeningBook::probe(uint64_t hash, int maxDepth) const {
+    if (keys == nullptr) {
+        return -1;
+    }
+    
+    const uint64_t* found = std::lower_bound(keys, keys + entryCount, hash);
+    if (found == keys + entryCount || *found != hash) {
+        return -1;
+    }
+    
+    const Move& move = moves[found - keys];
+    return move.depth <= maxDepth ? move.pit : -1;
+}
+
+OpeningBook::Header OpeningBook::makeHeader(uint32_t plies, uint64_t entryCount) {
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.plies = plies;
+    header.entryCount = entryCount;
+    return header;
+}
@@ -0,0 +1,55 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "mappedfile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Precomputed best moves for the positions of the first few plies, read
+// from a file written by the bookgen tool.
+//
+// File layout: Header, then entryCount Zobrist keys in ascending order,
+// then one Move per key in the same order. Keys and moves are kept apart
+// so a binary search only touches the key array.
+class OpeningBook {
+public:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t plies;      // Sowings from the start position the book covers
+        uint64_t entryCount;
+    };
+    
+    struct Move {
+        int8_t pit;          // Best move found
+        uint8_t depth;       // Depth it was searched to
+    };
+    
+    static const uint32_t VERSION = 1;
+    
+    OpeningBook();
+    
+    // Memory-map a book file; returns false if it is missing or invalid
+    bool open(const std::string& path);
+    void close();
+    
+    bool isOpen() const { return keys != nullptr; }
+    size_t size() const { return entryCount; }
+    
+    // Book move for the position with the given Zobrist hash, or -1. Moves
+    // searched deeper than maxDepth are left out too, so a shallow engine
+    // does not play above its level.
+    int probe(uint64_t hash, int maxDepth) const;
+    
+    // Header for a book with the given number of entries
+    static Header makeHeader(uint32_t plies, uint64_t entryCount);
+    
+private:
+    MappedFile file;
+    const uint64_t* keys;
+    const Move* moves;
+    size_t entryCount;
+};
+
+#endif // OPENINGBOOK_H
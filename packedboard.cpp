@@ -0,0 +1,47 @@
+#include "packedboard.h"
+
+namespace {
+    template <class Board>
+    PackedBoard::Tables<Board> generateTables() {
+        typedef PackedBoard::Tables<Board> Tables;
+        Tables generated = {};
+        
+        for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+            // Stores are never sown; their entries stay empty
+            bool player1Pit = pit < Board::PLAYER1_STORE;
+            int opponentStore = player1Pit ? Board::PLAYER2_STORE : Board::PLAYER1_STORE;
+            
+            for (int stones = 0; stones <= Board::TOTAL_STONES; stones++) {
+                // Walk the stones around exactly like the scalar makeMove
+                uint8_t added[16] = {};
+                int currentPit = pit;
+                bool sowable = pit != Board::PLAYER1_STORE && pit != Board::PLAYER2_STORE;
+                for (int left = sowable ? stones : 0; left > 0; ) {
+                    currentPit = (currentPit + 1) % Board::TOTAL_PITS;
+                    if (currentPit == opponentStore) {
+                        continue;
+                    }
+                    added[currentPit]++;
+                    left--;
+                }
+                
+                generated.sow[pit][stones] = PackedBoard::load<Board>(added);
+                generated.lastPit[pit][stones] = static_cast<int8_t>(currentPit);
+                if (sowable && stones > 0 && stones <= Tables::LAP_PITS) {
+                    generated.path[pit][stones - 1] = static_cast<int8_t>(currentPit);
+                }
+            }
+        }
+        
+        return generated;
+    }
+}
+
+namespace PackedBoard {
+    template <class Board>
+    const Tables<Board> Tables<Board>::instance = generateTables<Board>();
+    
+#define INSTANTIATE_TABLES(PITS, STONES) template struct Tables<BasicMancala<PITS, STONES> >;
+    MANCALA_VARIANTS(INSTANTIATE_TABLES)
+#undef INSTANTIATE_TABLES
+}
@@ -0,0 +1,114 @@
+#ifndef PACKEDBOARD_H
+#define PACKEDBOARD_H
+
+#include "board.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "PackedBoard assumes little-endian byte lanes"
+#endif
+
+// SWAR view of a board's pits: the one-byte pits loaded into two 64-bit
+// words, pits 0-7 in lo and the rest in the low bytes of hi (pits 8-13 for
+// the standard board). No pit ever holds more than TOTAL_STONES, so byte
+// lanes never carry into each other and whole laps of sowing become a
+// single add. Every function takes the board type, whose pit count fixes
+// the masks at compile time.
+// Used by board.cpp when built with MANCALA_SWAR_BOARD.
+namespace PackedBoard {
+    struct Lanes {
+        uint64_t lo;
+        uint64_t hi;
+    };
+    
+    // Byte lanes [first, first + count) of the pits that fall into word 0 (lo) or 1 (hi)
+    constexpr uint64_t laneMask(int first, int count, int word) {
+        uint64_t mask = 0;
+        for (int pit = first; pit < first + count; pit++) {
+            if (pit / 8 == word) {
+                mask |= 0xFFULL << (8 * (pit % 8));
+            }
+        }
+        return mask;
+    }
+    
+    // Lane masks for each side's small pits
+    template <class Board>
+    struct Masks {
+        static const uint64_t PLAYER1_PITS_LO = laneMask(0, Board::PITS_PER_PLAYER, 0);
+        static const uint64_t PLAYER1_PITS_HI = laneMask(0, Board::PITS_PER_PLAYER, 1);
+        static const uint64_t PLAYER2_PITS_LO = laneMask(Board::PLAYER1_STORE + 1, Board::PITS_PER_PLAYER, 0);
+        static const uint64_t PLAYER2_PITS_HI = laneMask(Board::PLAYER1_STORE + 1, Board::PITS_PER_PLAYER, 1);
+        
+        static_assert(Board::TOTAL_PITS > 8 && Board::TOTAL_PITS <= 16, "PackedBoard needs 9 to 16 pits");
+        static_assert(Board::TOTAL_STONES < 256, "Pit counts must fit in a byte lane");
+    };
+    
+    // Per (pit, stone count): the stones each pit receives when the pit is
+    // sown, and the pit the last stone lands in. path lists the pits a sowing
+    // from each pit reaches, in order, for callers that track pit changes.
+    template <class Board>
+    struct Tables {
+        // Sowing reaches at most this many distinct pits (all but the opponent's store)
+        static const int LAP_PITS = Board::TOTAL_PITS - 1;
+        
+        Lanes sow[Board::TOTAL_PITS][Board::TOTAL_STONES + 1];
+        int8_t lastPit[Board::TOTAL_PITS][Board::TOTAL_STONES + 1];
+        int8_t path[Board::TOTAL_PITS][LAP_PITS];
+        
+        static const Tables instance;
+    };
+    
+    template <class Board>
+    inline Lanes load(const uint8_t* pits) {
+        Lanes lanes = { 0, 0 };
+        std::memcpy(&lanes.lo, pits, 8);
+        std::memcpy(&lanes.hi, pits + 8, Board::TOTAL_PITS - 8);
+        return lanes;
+    }
+    
+    template <class Board>
+    inline void store(const Lanes& lanes, uint8_t* pits) {
+        std::memcpy(pits, &lanes.lo, 8);
+        std::memcpy(pits + 8, &lanes.hi, Board::TOTAL_PITS - 8);
+    }
+    
+    // Sum of all byte lanes; valid because any sum fits in a byte
+    inline int sumBytes(uint64_t word) {
+        return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+    }
+    
+    // The masks are constants, so the hi half folds away for boards whose
+    // side fits entirely in lo
+    template <class Board>
+    inline int player1SideStones(const Lanes& lanes) {
+        typedef Masks<Board> M;
+        return sumBytes((lanes.lo & M::PLAYER1_PITS_LO) + (lanes.hi & M::PLAYER1_PITS_HI));
+    }
+    
+    template <class Board>
+    inline int player2SideStones(const Lanes& lanes) {
+        typedef Masks<Board> M;
+        return sumBytes((lanes.lo & M::PLAYER2_PITS_LO) + (lanes.hi & M::PLAYER2_PITS_HI));
+    }
+    
+    template <class Board>
+    inline bool sideEmpty(const Lanes& lanes) {
+        typedef Masks<Board> M;
+        return ((lanes.lo & M::PLAYER1_PITS_LO) | (lanes.hi & M::PLAYER1_PITS_HI)) == 0 ||
+               ((lanes.lo & M::PLAYER2_PITS_LO) | (lanes.hi & M::PLAYER2_PITS_HI)) == 0;
+    }
+    
+    inline Lanes add(const Lanes& a, const Lanes& b) {
+        Lanes sum = { a.lo + b.lo, a.hi + b.hi };
+        return sum;
+    }
+    
+    inline Lanes subtract(const Lanes& a, const Lanes& b) {
+        Lanes difference = { a.lo - b.lo, a.hi - b.hi };
+        return difference;
+    }
+}
+
+#endif // PACKEDBOARD_H
@@ -0,0 +1,205 @@
+// Perft: counts the leaf positions of the full game tree to a given depth,
+// to check the rules engine against known counts and to measure raw
+// makeMove / getPossibleMoves throughput.
+//
+// Three ways of counting depth are checked:
+// - plies: every sowing is one ply, extra turns included;
+// - turns: a whole turn is one ply, so an extra turn keeps sowing at the
+//   same depth and every leaf is a position where the turn has passed
+//   (or the game has ended);
+// - merged: like turns, but through TurnGenerator, so chains of sowings
+//   that end in the same position count once.
+// A finished game is always a leaf.
+//
+// Usage: perft                      run the suite, exit code 1 on a mismatch
+//        perft <depth> <14 pits> <side to move, 1 or 2>
+//                                   count plies, turns and merged turns for one position
+
+#include "board.h"
+#include "evalfeatures.h"
+#include "turngen.h"
+#include "zobrist.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    struct SuitePosition {
+        const char* name;
+        MancalaBoard board;
+        std::vector<uint64_t> plies;  // Expected counts for depth 1, 2, ...
+        std::vector<uint64_t> turns;
+        std::vector<uint64_t> merged;
+    };
+    
+    // Counts from an independent straightforward implementation of the rules
+    std::vector<SuitePosition> suite() {
+        return {
+            { "start",
+              { { 4, 4, 4, 4, 4, 4, 0, 4, 4, 4, 4, 4, 4, 0 }, true },
+              { 6, 35, 185, 942, 4690, 23233, 114430, 563055, 2763490, 13519608 },
+              { 10, 116, 1022, 9682, 125843, 1090937 },
+              { 10, 116, 1022, 9682, 125843, 1090937 } },
+            { "midgame",
+              { { 2, 1, 0, 3, 6, 1, 9, 5, 0, 2, 7, 1, 3, 8 }, true },
+              { 5, 22, 98, 393, 1639, 6440, 25307, 97986, 377448, 1444876 },
+              { 16, 168, 976, 10292, 58796, 412492 },
+              { 16, 168, 976, 10292, 58754, 412351 } },
+            { "laps",  // 20 stones in one pit sow more than one lap
+              { { 0, 0, 0, 0, 0, 20, 10, 1, 1, 1, 1, 1, 1, 12 }, true },
+              { 1, 6, 35, 179, 877, 3799, 16032, 62693, 240119, 890968 },
+              { 1, 10, 98, 673, 5146, 27360, 239829 },
+              { 1, 10, 98, 673, 5146, 27360, 239766 } },
+            { "captures",
+              { { 1, 0, 3, 0, 0, 2, 15, 0, 4, 0, 3, 1, 0, 19 }, false },
+              { 3, 7, 19, 52, 143, 407, 1193, 3249, 8487, 20305, 46165, 99850 },
+              { 8, 20, 82, 198, 837, 2697, 9569, 26451, 67779 },
+              { 8, 20, 82, 198, 835, 2694, 9494, 26126, 66892 } },
+            { "endgame",  // Every line ends the game within four sowings
+              { { 0, 1, 0, 0, 2, 0, 21, 1, 0, 1, 0, 0, 1, 21 }, false },
+              { 3, 5, 9, 11, 11, 11 },
+              { 4, 8, 11, 11, 11, 11 },
+              { 4, 8, 9, 9, 9, 9 } },
+        };
+    }
+    
+    uint64_t perftPlies(MancalaBoard& board, int depth) {
+        if (depth == 0 || board.isGameOver()) {
+            return 1;
+        }
+        
+        int moves[MancalaBoard::PITS_PER_PLAYER];
+        int moveCount = board.getPossibleMoves(moves);
+        uint64_t nodes = 0;
+        for (int i = 0; i < moveCount; i++) {
+            MoveUndo undo;
+            board.makeMove(moves[i], undo);
+            nodes += perftPlies(board, depth - 1);
+            board.unmakeMove(undo);
+        }
+        return nodes;
+    }
+    
+    uint64_t perftTurns(MancalaBoard& board, int depth) {
+        if (depth == 0 || board.isGameOver()) {
+            return 1;
+        }
+        
+        int moves[MancalaBoard::PITS_PER_PLAYER];
+        int moveCount = board.getPossibleMoves(moves);
+        uint64_t nodes = 0;
+        for (int i = 0; i < moveCount; i++) {
+            MoveUndo undo;
+            board.makeMove(moves[i], undo);
+            // An extra turn continues the same turn; a finished game is a leaf either way
+            bool sameTurn = !undo.turnFlipped && !undo.swept;
+            nodes += perftTurns(board, sameTurn ? depth : depth - 1);
+            board.unmakeMove(undo);
+        }
+        return nodes;
+    }
+    
+    // One generator and turn list per depth, reused across calls
+    struct MergedPerft {
+        TurnGenerator generator;
+        std::vector<std::vector<Turn> > turns;
+        
+        uint64_t count(const MancalaBoard& board, int depth) {
+            turns.resize(depth + 1);
+            return count(board, Zobrist::hash(board), EvalFeatures::compute(board), depth);
+        }
+        
+        uint64_t count(const MancalaBoard& board, uint64_t hash, const EvalFeatures& features, int depth) {
+            if (depth == 0 || board.isGameOver()) {
+                return 1;
+            }
+            
+            std::vector<Turn>& list = turns[depth];
+            generator.generate(board, hash, features, list);
+            uint64_t nodes = 0;
+            for (const Turn& turn : list) {
+                nodes += count(turn.board, turn.hash, turn.features, depth - 1);
+            }
+            return nodes;
+        }
+    };
+    
+    // Run one count and report it; returns false on a mismatch
+    template <typename Count>
+    bool check(const char* mode, int depth, uint64_t expected, Count count, uint64_t& totalNodes, double& totalSeconds) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = count();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        totalNodes += nodes;
+        totalSeconds += seconds;
+        
+        bool ok = expected == 0 || nodes == expected;
+        std::printf("  %-6s %2d %12llu", mode, depth, static_cast<unsigned long long>(nodes));
+        if (expected != 0) {
+            std::printf(ok ? "  ok" : "  MISMATCH, expected %llu", static_cast<unsigned long long>(expected));
+        }
+        std::printf("\n");
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+    bool allOk = true;
+    
+    if (argc > 1) {
+        // One position given on the command line, no expected counts
+        if (argc != 17) {
+            std::fprintf(stderr, "Usage: %s [<depth> <14 pits> <side to move, 1 or 2>]\n", argv[0]);
+            return 1;
+        }
+        
+        int depth = std::atoi(argv[1]);
+        MancalaBoard board;
+        for (int i = 0; i < MancalaBoard::TOTAL_PITS; i++) {
+            board.pits[i] = static_cast<uint8_t>(std::atoi(argv[2 + i]));
+        }
+        board.player1Turn = std::atoi(argv[16]) == 1;
+        
+        for (int d = 1; d <= depth; d++) {
+            check("plies", d, 0, [&]() { return perftPlies(board, d); }, totalNodes, totalSeconds);
+        }
+        for (int d = 1; d <= depth; d++) {
+            check("turns", d, 0, [&]() { return perftTurns(board, d); }, totalNodes, totalSeconds);
+        }
+        MergedPerft merged;
+        for (int d = 1; d <= depth; d++) {
+            check("merged", d, 0, [&]() { return merged.count(board, d); }, totalNodes, totalSeconds);
+        }
+    } else {
+        for (SuitePosition& position : suite()) {
+            std::printf("%s\n", position.name);
+            for (size_t i = 0; i < position.plies.size(); i++) {
+                int depth = static_cast<int>(i) + 1;
+                allOk &= check("plies", depth, position.plies[i],
+                               [&]() { return perftPlies(position.board, depth); }, totalNodes, totalSeconds);
+            }
+            for (size_t i = 0; i < position.turns.size(); i++) {
+                int depth = static_cast<int>(i) + 1;
+                allOk &= check("turns", depth, position.turns[i],
+                               [&]() { return perftTurns(position.board, depth); }, totalNodes, totalSeconds);
+            }
+            MergedPerft merged;
+            for (size_t i = 0; i < position.merged.size(); i++) {
+                int depth = static_cast<int>(i) + 1;
+                allOk &= check("merged", depth, position.merged[i],
+                               [&]() { return merged.count(position.board, depth); }, totalNodes, totalSeconds);
+            }
+        }
+    }
+    
+    std::printf("%llu nodes in %.3f s, %.0f nodes/s\n", static_cast<unsigned long long>(totalNodes),
+                totalSeconds, totalSeconds > 0.0 ? totalNodes / totalSeconds : 0.0);
+    if (!allOk) {
+        std::printf("Perft suite FAILED\n");
+        return 1;
+    }
+    return 0;
+}
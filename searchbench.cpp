@@ -0,0 +1,81 @@
+// Fixed-depth search benchmark: searches a fixed suite of positions to the
+// same depth on one thread and reports nodes, time and the chosen move for
+// each, so changes to pruning and move ordering can be compared by node
+// count at equal depth. Each search starts from an empty transposition
+// table.
+//
+// Usage: searchbench [depth]   (default 12)
+
+#include "ai.h"
+#include "board.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    const int DEFAULT_DEPTH = 12;
+    const int POSITION_COUNT = 16;
+    
+    // The start position plus positions after random playouts with a fixed seed
+    std::vector<MancalaBoard> suite() {
+        std::mt19937 rng(2024);
+        std::vector<MancalaBoard> positions;
+        
+        MancalaBoard start;
+        start.reset();
+        positions.push_back(start);
+        
+        while (positions.size() < static_cast<size_t>(POSITION_COUNT)) {
+            MancalaBoard board;
+            board.reset();
+            int plies = 2 + static_cast<int>(rng() % 30);
+            for (int ply = 0; ply < plies && !board.isGameOver(); ply++) {
+                int moves[MancalaBoard::PITS_PER_PLAYER];
+                int moveCount = board.getPossibleMoves(moves);
+                board.makeMove(moves[rng() % moveCount]);
+            }
+            if (!board.isGameOver()) {
+                positions.push_back(board);
+            }
+        }
+        
+        return positions;
+    }
+}
+
+int main(int argc, char** argv) {
+    int depth = argc > 1 ? std::atoi(argv[1]) : DEFAULT_DEPTH;
+    if (depth < 1) {
+        std::fprintf(stderr, "Usage: searchbench [depth]\n");
+        return 1;
+    }
+    
+    std::vector<MancalaBoard> positions = suite();
+    MancalaAI ai;
+    ai.setSearchDepth(depth);
+    
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+    
+    std::printf("depth %d\n", depth);
+    for (size_t i = 0; i < positions.size(); i++) {
+        // Every position starts cold, so its count does not depend on the others
+        ai.clearSearchState();
+        
+        auto start = std::chrono::steady_clock::now();
+        int move = ai.findBestMove(positions[i]);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        uint64_t nodes = ai.getLastSearchNodes();
+        totalNodes += nodes;
+        totalSeconds += seconds;
+        std::printf("%2zu: move %2d %12llu nodes %9.1f ms\n", i + 1, move,
+                    static_cast<unsigned long long>(nodes), 1000.0 * seconds);
+    }
+    
+    std::printf("total %llu nodes, %.1f ms, %.0f nodes/s\n", static_cast<unsigned long long>(totalNodes),
+                1000.0 * totalSeconds, totalSeconds > 0.0 ? totalNodes / totalSeconds : 0.0);
+    return 0;
+}
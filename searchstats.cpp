@@ -0,0 +1,54 @@
+#include "searchstats.h"
+
+double SearchStats::firstMoveCutoffRate() const {
+    return cutoffs > 0 ? static_cast<double>(firstMoveCutoffs) / cutoffs : 0.0;
+}
+
+double SearchStats::hashHitRate() const {
+    return hashProbes > 0 ? static_cast<double>(hashHits) / hashProbes : 0.0;
+}
+
+double SearchStats::effectiveBranchingFactor() const {
+    if (iterations.size() < 2) {
+        return 0.0;
+    }
+    const IterationStats& previous = iterations[iterations.size() - 2];
+    const IterationStats& last = iterations.back();
+    return previous.nodes > 0 ? static_cast<double>(last.nodes) / previous.nodes : 0.0;
+}
+
+void SearchStats::writeJson(std::ostream& out) const {
+    out << "{\"move\":" << move
+        << ",\"book\":" << (bookMove ? "true" : "false")
+        << ",\"planned\":" << (plannedMove ? "true" : "false")
+        << ",\"threads\":" << threads
+        << ",\"depth\":" << completedDepth
+        << ",\"ms\":" << milliseconds
+        << ",\"nodes\":" << nodes
+        << ",\"leaves\":" << leaves
+        << ",\"quiescenceNodes\":" << quiescenceNodes
+        << ",\"reductions\":" << reductions
+        << ",\"reSearches\":" << reSearches
+        << ",\"futilityPrunes\":" << futilityPrunes
+        << ",\"razorCuts\":" << razorCuts
+        << ",\"cutoffs\":" << cutoffs
+        << ",\"firstMoveCutoffRate\":" << firstMoveCutoffRate()
+        << ",\"hashProbes\":" << hashProbes
+        << ",\"hashHits\":" << hashHits
+        << ",\"tablebaseHits\":" << tablebaseHits
+        << ",\"maxPly\":" << maxPly
+        << ",\"ebf\":" << effectiveBranchingFactor()
+        << ",\"iterations\":[";
+    
+    for (size_t i = 0; i < iterations.size(); i++) {
+        const IterationStats& iteration = iterations[i];
+        out << (i > 0 ? "," : "")
+            << "{\"depth\":" << iteration.depth
+            << ",\"move\":" << iteration.move
+            << ",\"score\":" << iteration.score
+            << ",\"nodes\":" << iteration.nodes
+            << ",\"ms\":" << iteration.milliseconds << "}";
+    }
+    
+    out << "]}\n";
+}
@@ -0,0 +1,64 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Per-node search counters are only collected when built with
+// MANCALA_SEARCH_STATS; otherwise SEARCH_STAT compiles to nothing (the
+// statement is still type-checked) and those counters stay zero. Node
+// counts, cutoffs, hash and tablebase hits and per-iteration data are
+// always collected, since the search and MancalaAI's accessors need them.
+#ifdef MANCALA_SEARCH_STATS
+#define SEARCH_STAT(statement) statement
+#else
+#define SEARCH_STAT(statement) do { if (false) { statement; } } while (0)
+#endif
+
+// One completed iterative deepening iteration of the main search thread
+struct IterationStats {
+    int depth;
+    int move;               // Best move of the iteration
+    int score;              // Its score, converted to Player 2's point of view
+    uint64_t nodes;         // Nodes the main thread visited in this iteration
+    double milliseconds;    // Time since the search started when it completed
+};
+
+// What one findBestMove call did
+struct SearchStats {
+    int move = -1;
+    bool bookMove = false;      // Answered from the opening book without searching
+    bool plannedMove = false;   // Continued the whole turn chosen by the previous search
+    int threads = 1;
+    int completedDepth = 0;
+    double milliseconds = 0.0;
+    uint64_t nodes = 0;         // All threads
+    uint64_t cutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;  // Cutoffs caused by the first move tried
+    uint64_t hashProbes = 0;
+    uint64_t hashHits = 0;
+    uint64_t tablebaseHits = 0;
+    
+    // Counted only with MANCALA_SEARCH_STATS (all threads)
+    uint64_t leaves = 0;            // Positions scored by the evaluation function
+    uint64_t quiescenceNodes = 0;   // Positions visited by the quiescence search
+    uint64_t reductions = 0;        // Late moves searched at reduced depth
+    uint64_t reSearches = 0;        // Reduced searches that had to be repeated at full depth
+    uint64_t futilityPrunes = 0;    // Quiet moves skipped near the leaves
+    uint64_t razorCuts = 0;         // Nodes settled by the quiescence search below alpha
+    int maxPly = 0;                 // Deepest ply reached, extra-turn chains included
+    
+    std::vector<IterationStats> iterations;
+    
+    double firstMoveCutoffRate() const;
+    double hashHitRate() const;
+    
+    // Growth in nodes from the second-to-last to the last iteration
+    double effectiveBranchingFactor() const;
+    
+    // Write the stats as one JSON object on a single line
+    void writeJson(std::ostream& out) const;
+};
+
+#endif // SEARCHSTATS_H
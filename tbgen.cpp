@@ -0,0 +1,237 @@
+// Endgame tablebase generator.
+//
+// Solves every position with up to maxStones stones in the small pits and
+// writes the table MancalaAI memory-maps at startup (see endgame.h).
+//
+// Usage: tbgen <maxStones> <output file> [threads]
+//
+// Positions are solved backwards from the end of the game. A move either
+// drops at least one stone in a store (sowing past the own store, or a
+// capture), leaving fewer stones in play, or keeps every sown stone on the
+// mover's own side, moving them strictly closer to the store. So with
+// fewer stones solved first, and positions of the same stone count solved
+// in decreasing order of the distance their stones have travelled, every
+// successor of a position is already in the table. Positions with the same
+// stone count and distance never depend on each other and are solved in
+// parallel.
+
+#include "board.h"
+#include "endgame.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace {
+    const int KEY_PITS = EndgameTablebase::KEY_PITS;
+    const int SIDE_PITS = MancalaBoard::PITS_PER_PLAYER;
+    
+    // Ranks are kept in 32 bits while a stone count is being sorted
+    const int GENERATOR_MAX_STONES = 24;
+    
+    // How far the stones have travelled along their owners' sides; every
+    // move that keeps all stones in play increases it
+    int distanceTravelled(const int key[KEY_PITS]) {
+        int total = 0;
+        for (int i = 0; i < SIDE_PITS; i++) {
+            total += i * (key[i] + key[SIDE_PITS + i]);
+        }
+        return total;
+    }
+    
+    // Step key to the next composition of the same stone count in
+    // lexicographic order; returns false after the last one
+    bool nextComposition(int key[KEY_PITS]) {
+        int last = KEY_PITS - 1;
+        while (last > 0 && key[last] == 0) {
+            last--;
+        }
+        if (last == 0) {
+            return false;
+        }
+        
+        int rest = key[last] - 1;
+        key[last] = 0;
+        key[last - 1]++;
+        key[KEY_PITS - 1] = rest;
+        return true;
+    }
+    
+    // Inverse of the lexicographic rank used by EndgameTablebase::index
+    void unrank(uint64_t rank, int stones, int key[KEY_PITS]) {
+        int remaining = stones;
+        for (int i = 0; i < KEY_PITS - 1; i++) {
+            int value = 0;
+            while (true) {
+                uint64_t block = EndgameTablebase::compositions(remaining - value, KEY_PITS - 1 - i);
+                if (rank < block) {
+                    break;
+                }
+                rank -= block;
+                value++;
+            }
+            key[i] = value;
+            remaining -= value;
+        }
+        key[KEY_PITS - 1] = remaining;
+    }
+    
+    // Board with the mover's pits as Player 1's and empty stores
+    MancalaBoard boardFromKey(const int key[KEY_PITS]) {
+        MancalaBoard board;
+        for (int i = 0; i < SIDE_PITS; i++) {
+            board.pits[i] = static_cast<uint8_t>(key[i]);
+            board.pits[MancalaBoard::PLAYER1_STORE + 1 + i] = static_cast<uint8_t>(key[SIDE_PITS + i]);
+        }
+        board.pits[MancalaBoard::PLAYER1_STORE] = 0;
+        board.pits[MancalaBoard::PLAYER2_STORE] = 0;
+        board.player1Turn = true;
+        return board;
+    }
+    
+    // Best final store difference for the mover; all successors that keep
+    // stones in play must already be in table
+    int solve(const int key[KEY_PITS], const std::vector<int8_t>& table) {
+        MancalaBoard board = boardFromKey(key);
+        
+        // A finished game: the remaining stones go to their owners
+        if (board.isGameOver()) {
+            int moverStones = 0;
+            int opponentStones = 0;
+            for (int i = 0; i < SIDE_PITS; i++) {
+                moverStones += key[i];
+                opponentStones += key[SIDE_PITS + i];
+            }
+            return moverStones - opponentStones;
+        }
+        
+        int moves[SIDE_PITS];
+        int moveCount = board.getPossibleMoves(moves);
+        int best = -MancalaBoard::TOTAL_STONES - 1;
+        
+        for (int i = 0; i < moveCount; i++) {
+            MancalaBoard next = board;
+            MoveUndo undo;
+            next.makeMove(moves[i], undo);
+            
+            int gained = next.pits[MancalaBoard::PLAYER1_STORE] - next.pits[MancalaBoard::PLAYER2_STORE];
+            int score;
+            if (undo.swept) {
+                score = gained;
+            } else {
+                int nextKey[KEY_PITS];
+                EndgameTablebase::makeKey(next, nextKey);
+                int rest = table[EndgameTablebase::index(nextKey)];
+                score = undo.turnFlipped ? gained - rest : gained + rest;
+            }
+            best = std::max(best, score);
+        }
+        
+        return best;
+    }
+    
+    // Solve all positions with exactly the given number of stones
+    void solveStones(int stones, int threadCount, std::vector<int8_t>& table) {
+        uint64_t count = EndgameTablebase::compositions(stones, KEY_PITS);
+        uint64_t offset = EndgameTablebase::entryCount(stones - 1);
+        int maxDistance = (SIDE_PITS - 1) * stones;
+        
+        // Counting sort of the ranks by distance travelled
+        std::vector<uint32_t> bucketStart(maxDistance + 2, 0);
+        int key[KEY_PITS] = {};
+        key[KEY_PITS - 1] = stones;
+        do {
+            bucketStart[distanceTravelled(key) + 1]++;
+        } while (nextComposition(key));
+        for (int d = 0; d <= maxDistance; d++) {
+            bucketStart[d + 1] += bucketStart[d];
+        }
+        
+        std::vector<uint32_t> order(count);
+        std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+        std::fill(key, key + KEY_PITS, 0);
+        key[KEY_PITS - 1] = stones;
+        uint32_t rank = 0;
+        do {
+            order[fill[distanceTravelled(key)]++] = rank++;
+        } while (nextComposition(key));
+        
+        // Furthest travelled first; each bucket is split across the threads
+        for (int d = maxDistance; d >= 0; d--) {
+            uint32_t begin = bucketStart[d];
+            uint32_t end = bucketStart[d + 1];
+            
+            auto work = [&](int part) {
+                uint64_t size = end - begin;
+                uint32_t from = begin + static_cast<uint32_t>(size * part / threadCount);
+                uint32_t to = begin + static_cast<uint32_t>(size * (part + 1) / threadCount);
+                int position[KEY_PITS];
+                for (uint32_t i = from; i < to; i++) {
+                    unrank(order[i], stones, position);
+                    table[offset + order[i]] = static_cast<int8_t>(solve(position, table));
+                }
+            };
+            
+            if (threadCount == 1 || end - begin < 1024) {
+                for (int part = 0; part < threadCount; part++) {
+                    work(part);
+                }
+            } else {
+                std::vector<std::thread> workers;
+                for (int part = 1; part < threadCount; part++) {
+                    workers.emplace_back(work, part);
+                }
+                work(0);
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: %s <maxStones> <output file> [threads]\n", argv[0]);
+        return 1;
+    }
+    
+    int maxStones = std::atoi(argv[1]);
+    if (maxStones < 0 || maxStones > GENERATOR_MAX_STONES) {
+        std::fprintf(stderr, "maxStones must be between 0 and %d\n", GENERATOR_MAX_STONES);
+        return 1;
+    }
+    
+    // Threads: 0 or missing uses every core
+    int threadCount = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, threadCount);
+    
+    EndgameTablebase::Header header = EndgameTablebase::makeHeader(maxStones);
+    std::vector<int8_t> table(header.entryCount);
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int stones = 0; stones <= maxStones; stones++) {
+        solveStones(stones, threadCount, table);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%2d stones: %llu positions solved, %.1f s\n", stones,
+                    static_cast<unsigned long long>(EndgameTablebase::entryCount(stones)), seconds);
+    }
+    
+    std::ofstream out(argv[2], std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size()));
+    if (!out) {
+        std::fprintf(stderr, "Failed to write %s\n", argv[2]);
+        return 1;
+    }
+    
+    std::printf("Wrote %s (%llu bytes)\n", argv[2],
+                static_cast<unsigned long long>(sizeof(header) + table.size()));
+    return 0;
+}
@@ -0,0 +1,401 @@
+// Headless self-play tournament between two MancalaAI configurations.
+//
+// Games are played in pairs from the same randomized opening, once with
+// each engine as Player 1, and the pairs are spread over a pool of worker
+// threads. Reports the result from engine A's point of view with an Elo
+// estimate and 95% confidence interval, plus each engine's average move
+// time, depth and nodes per second. Either engine can be the alpha-beta
+// MancalaAI or the MCTSEngine, on any of the board variants.
+//
+// Usage: tournament [options]
+//   --games N            games to play, rounded up to an even number (default 200)
+//   --threads N          games played in parallel, 0 for every core (default 0)
+//   --random-plies N     random sowings before the engines take over (default 4)
+//   --seed N             seed for the random openings (default 1)
+//   --variant P,S        board with P pits per side and S stones per pit (default 6,4)
+//   --a-engine NAME      engine A search, minimax or mcts (default minimax)
+//   --a-difficulty N     engine A difficulty 1-5 (default 3)
+//   --a-depth N          engine A fixed depth, overrides the difficulty (minimax)
+//   --a-playouts N       engine A playouts per move, overrides the difficulty (mcts)
+//   --a-time MS          engine A time per move, overrides the depth
+//   --a-search-threads N engine A Lazy SMP threads per search (default 1)
+//   --a-quiescence 0|1   engine A quiescence search (minimax, default 1)
+//   --a-lmr 0|1          engine A late move reductions (minimax, default 1)
+//   --a-futility 0|1     engine A futility pruning (minimax, default 1)
+//   --a-razoring 0|1     engine A razoring (minimax, default 1)
+//   --a-whole-turns 0|1  engine A searches by whole turns (minimax, default 0)
+//   --a-tablebase FILE   engine A endgame tablebase (minimax, 6,4 only)
+//   --a-book FILE        engine A opening book (minimax, 6,4 only)
+//   --b-...              the same for engine B
+
+#include "ai.h"
+#include "board.h"
+#include "engine.h"
+#include "mcts.h"
+#include "variant.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct EngineConfig {
+        bool mcts = false;
+        int difficulty = 3;
+        int depth = 0;         // 0: from the difficulty
+        int playouts = 0;      // 0: from the difficulty
+        int timeMs = 0;        // 0: search to depth
+        int searchThreads = 1;
+        bool quiescence = true;
+        bool lateMoveReductions = true;
+        bool futilityPruning = true;
+        bool razoring = true;
+        bool wholeTurns = false;
+        std::string tablebase;
+        std::string book;
+    };
+    
+    struct Options {
+        int games = 200;
+        int threads = 0;
+        int randomPlies = 4;
+        unsigned seed = 1;
+        int pits = MancalaBoard::PITS_PER_PLAYER;
+        int stones = MancalaBoard::INITIAL_STONES;
+        EngineConfig engines[2];
+    };
+    
+    // Per-engine totals over all of its moves
+    struct EngineStats {
+        uint64_t moves = 0;
+        uint64_t nodes = 0;
+        uint64_t depthSum = 0;
+        double seconds = 0.0;
+    };
+    
+    struct Results {
+        int wins = 0;    // For engine A
+        int draws = 0;
+        int losses = 0;
+        EngineStats engines[2];
+    };
+    
+    template <class Board>
+    std::unique_ptr<BasicEngine<Board> > createEngine(const EngineConfig& config) {
+        if (config.mcts) {
+            std::unique_ptr<BasicMCTSEngine<Board> > mcts(new BasicMCTSEngine<Board>(config.difficulty));
+            if (config.playouts > 0) {
+                mcts->setPlayouts(config.playouts);
+            }
+            mcts->setThreads(config.searchThreads);
+            return std::unique_ptr<BasicEngine<Board> >(mcts.release());
+        }
+        
+        std::unique_ptr<BasicMancalaAI<Board> > ai(new BasicMancalaAI<Board>(config.difficulty));
+        if (config.depth > 0) {
+            ai->setSearchDepth(config.depth);
+        }
+        ai->setThreads(config.searchThreads);
+        ai->setQuiescence(config.quiescence);
+        ai->setLateMoveReductions(config.lateMoveReductions);
+        ai->setFutilityPruning(config.futilityPruning);
+        ai->setRazoring(config.razoring);
+        ai->setWholeTurns(config.wholeTurns);
+        if (!config.tablebase.empty() && !ai->loadTablebase(config.tablebase)) {
+            std::fprintf(stderr, "Could not load tablebase %s\n", config.tablebase.c_str());
+            std::exit(1);
+        }
+        if (!config.book.empty() && !ai->loadOpeningBook(config.book)) {
+            std::fprintf(stderr, "Could not load opening book %s\n", config.book.c_str());
+            std::exit(1);
+        }
+        return std::unique_ptr<BasicEngine<Board> >(ai.release());
+    }
+    
+    // Start position followed by a few random sowings, the same for both
+    // games of a pair
+    template <class Board>
+    Board randomOpening(unsigned seed, int plies) {
+        std::mt19937 rng(seed);
+        Board board;
+        do {
+            board.reset();
+            for (int ply = 0; ply < plies && !board.isGameOver(); ply++) {
+                int moves[Board::PITS_PER_PLAYER];
+                int moveCount = board.getPossibleMoves(moves);
+                board.makeMove(moves[rng() % moveCount]);
+            }
+        } while (board.isGameOver());
+        return board;
+    }
+    
+    // Play one game; engines[0] moves for Player 1. Returns the winner as
+    // in MancalaBoard::getWinner.
+    template <class Board>
+    int playGame(Board board, BasicEngine<Board>* engines[2], const EngineConfig* configs[2], EngineStats* stats[2]) {
+        while (!board.isGameOver()) {
+            int side = board.isPlayer1Turn() ? 0 : 1;
+            BasicEngine<Board>& ai = *engines[side];
+            
+            auto start = std::chrono::steady_clock::now();
+            int move = configs[side]->timeMs > 0
+                ? ai.findBestMove(board, std::chrono::milliseconds(configs[side]->timeMs))
+                : ai.findBestMove(board);
+            stats[side]->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            stats[side]->moves++;
+            stats[side]->nodes += ai.getLastSearchNodes();
+            stats[side]->depthSum += ai.getLastSearchDepth();
+            
+            if (!board.makeMove(move)) {
+                std::fprintf(stderr, "Engine returned illegal move %d\n", move);
+                std::exit(1);
+            }
+        }
+        return board.getWinner();
+    }
+    
+    void accumulate(EngineStats& total, const EngineStats& part) {
+        total.moves += part.moves;
+        total.nodes += part.nodes;
+        total.depthSum += part.depthSum;
+        total.seconds += part.seconds;
+    }
+    
+    template <class Board>
+    Results runTournament(const Options& options) {
+        int pairs = (options.games + 1) / 2;
+        Results results;
+        std::mutex resultsMutex;
+        std::atomic<int> nextPair(0);
+        
+        auto work = [&]() {
+            std::unique_ptr<BasicEngine<Board> > engineA = createEngine<Board>(options.engines[0]);
+            std::unique_ptr<BasicEngine<Board> > engineB = createEngine<Board>(options.engines[1]);
+            
+            for (int pair = nextPair++; pair < pairs; pair = nextPair++) {
+                Board opening = randomOpening<Board>(options.seed + pair, options.randomPlies);
+                Results local;
+                
+                for (int aSide = 0; aSide < 2; aSide++) {
+                    BasicEngine<Board>* engines[2];
+                    const EngineConfig* configs[2];
+                    EngineStats* stats[2];
+                    engines[aSide] = engineA.get();
+                    engines[1 - aSide] = engineB.get();
+                    configs[aSide] = &options.engines[0];
+                    configs[1 - aSide] = &options.engines[1];
+                    stats[aSide] = &local.engines[0];
+                    stats[1 - aSide] = &local.engines[1];
+                    
+                    int winner = playGame(opening, engines, configs, stats);
+                    if (winner == 0) {
+                        local.draws++;
+                    } else if (winner - 1 == aSide) {
+                        local.wins++;
+                    } else {
+                        local.losses++;
+                    }
+                }
+                
+                std::lock_guard<std::mutex> lock(resultsMutex);
+                results.wins += local.wins;
+                results.draws += local.draws;
+                results.losses += local.losses;
+                accumulate(results.engines[0], local.engines[0]);
+                accumulate(results.engines[1], local.engines[1]);
+                
+                int played = results.wins + results.draws + results.losses;
+                if (played % 100 == 0) {
+                    std::fprintf(stderr, "%d / %d games\n", played, 2 * pairs);
+                }
+            }
+        };
+        
+        int threadCount = options.threads > 0 ? options.threads : static_cast<int>(std::thread::hardware_concurrency());
+        threadCount = std::max(1, std::min(threadCount, pairs));
+        
+        std::vector<std::thread> workers;
+        for (int i = 1; i < threadCount; i++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        
+        return results;
+    }
+    
+    // Elo difference that gives the expected score
+    double eloFromScore(double score) {
+        return -400.0 * std::log10(1.0 / score - 1.0);
+    }
+    
+    void printElo(const char* label, double score) {
+        if (score <= 0.0) {
+            std::printf("%s -inf", label);
+        } else if (score >= 1.0) {
+            std::printf("%s +inf", label);
+        } else {
+            std::printf("%s %+.1f", label, eloFromScore(score));
+        }
+    }
+    
+    void printEngine(const char* name, const EngineConfig& config, const EngineStats& stats) {
+        std::printf("%s: %s, difficulty %d", name, config.mcts ? "mcts" : "minimax", config.difficulty);
+        if (config.mcts && config.playouts > 0) {
+            std::printf(", %d playouts", config.playouts);
+        }
+        if (!config.mcts && config.depth > 0) {
+            std::printf(", depth %d", config.depth);
+        }
+        if (!config.mcts && !config.quiescence) {
+            std::printf(", no quiescence");
+        }
+        if (!config.mcts && !config.lateMoveReductions) {
+            std::printf(", no LMR");
+        }
+        if (!config.mcts && !config.futilityPruning) {
+            std::printf(", no futility");
+        }
+        if (!config.mcts && !config.razoring) {
+            std::printf(", no razoring");
+        }
+        if (!config.mcts && config.wholeTurns) {
+            std::printf(", whole turns");
+        }
+        if (config.timeMs > 0) {
+            std::printf(", %d ms/move", config.timeMs);
+        }
+        std::printf(", %d search thread(s)\n", config.searchThreads);
+        
+        double moves = stats.moves > 0 ? static_cast<double>(stats.moves) : 1.0;
+        double nps = stats.seconds > 0.0 ? stats.nodes / stats.seconds : 0.0;
+        std::printf("   %llu moves, %.3f ms/move, average depth %.2f, %.0f nodes/s\n",
+                    static_cast<unsigned long long>(stats.moves), 1000.0 * stats.seconds / moves,
+                    stats.depthSum / moves, nps);
+    }
+    
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string name = argv[i];
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", name.c_str());
+                return false;
+            }
+            std::string value = argv[++i];
+            
+            // Engine options start with --a- or --b-
+            EngineConfig* engine = nullptr;
+            if (name.compare(0, 4, "--a-") == 0) {
+                engine = &options.engines[0];
+            } else if (name.compare(0, 4, "--b-") == 0) {
+                engine = &options.engines[1];
+            }
+            
+            if (engine != nullptr) {
+                std::string field = name.substr(4);
+                if (field == "engine") {
+                    if (value != "minimax" && value != "mcts") {
+                        std::fprintf(stderr, "Unknown engine %s\n", value.c_str());
+                        return false;
+                    }
+                    engine->mcts = value == "mcts";
+                } else if (field == "difficulty") {
+                    engine->difficulty = std::atoi(value.c_str());
+                } else if (field == "depth") {
+                    engine->depth = std::atoi(value.c_str());
+                } else if (field == "playouts") {
+                    engine->playouts = std::atoi(value.c_str());
+                } else if (field == "time") {
+                    engine->timeMs = std::atoi(value.c_str());
+                } else if (field == "search-threads") {
+                    engine->searchThreads = std::atoi(value.c_str());
+                } else if (field == "quiescence") {
+                    engine->quiescence = std::atoi(value.c_str()) != 0;
+                } else if (field == "lmr") {
+                    engine->lateMoveReductions = std::atoi(value.c_str()) != 0;
+                } else if (field == "futility") {
+                    engine->futilityPruning = std::atoi(value.c_str()) != 0;
+                } else if (field == "razoring") {
+                    engine->razoring = std::atoi(value.c_str()) != 0;
+                } else if (field == "whole-turns") {
+                    engine->wholeTurns = std::atoi(value.c_str()) != 0;
+                } else if (field == "tablebase") {
+                    engine->tablebase = value;
+                } else if (field == "book") {
+                    engine->book = value;
+                } else {
+                    std::fprintf(stderr, "Unknown option %s\n", name.c_str());
+                    return false;
+                }
+            } else if (name == "--games") {
+                options.games = std::max(1, std::atoi(value.c_str()));
+            } else if (name == "--threads") {
+                options.threads = std::atoi(value.c_str());
+            } else if (name == "--random-plies") {
+                options.randomPlies = std::max(0, std::atoi(value.c_str()));
+            } else if (name == "--seed") {
+                options.seed = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+            } else if (name == "--variant") {
+                if (std::sscanf(value.c_str(), "%d,%d", &options.pits, &options.stones) != 2) {
+                    std::fprintf(stderr, "Variant must be pits,stones, not %s\n", value.c_str());
+                    return false;
+                }
+            } else {
+                std::fprintf(stderr, "Unknown option %s\n", name.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "See the comment at the top of tournament.cpp for the options\n");
+        return 1;
+    }
+    
+    // Pick the board instantiation once; the games run on its specialized code
+    auto start = std::chrono::steady_clock::now();
+    Results results;
+    bool built = withVariant(options.pits, options.stones, [&](auto board) {
+        results = runTournament<decltype(board)>(options);
+    });
+    if (!built) {
+        std::fprintf(stderr, "Variant %d,%d is not built, choose one of:" MANCALA_VARIANT_NAMES "\n", options.pits, options.stones);
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    int games = results.wins + results.draws + results.losses;
+    double score = (results.wins + 0.5 * results.draws) / games;
+    
+    // Normal approximation of the per-game score distribution
+    double variance = (results.wins * (1.0 - score) * (1.0 - score) +
+                       results.draws * (0.5 - score) * (0.5 - score) +
+                       results.losses * score * score) / games;
+    double margin = 1.96 * std::sqrt(variance / games);
+    
+    std::printf("Kalah(%d,%d): %d games in %.1f s\n", options.pits, options.stones, games, seconds);
+    printEngine("A", options.engines[0], results.engines[0]);
+    printEngine("B", options.engines[1], results.engines[1]);
+    std::printf("A vs B: +%d =%d -%d, score %.1f%%\n", results.wins, results.draws, results.losses, 100.0 * score);
+    printElo("Elo", score);
+    printElo(", 95% CI", std::max(0.0, score - margin));
+    printElo(" to", std::min(1.0, score + margin));
+    std::printf("\n");
+    
+    return 0;
+}
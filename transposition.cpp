@@ -0,0 +1,179 @@
+#include "transposition.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace {
+    // An all-zero slot must never look like a hit; depth -1 marks it empty
+    const uint64_t EMPTY_DATA = static_cast<uint64_t>(static_cast<uint8_t>(-1)) << 16;
+    
+    const char MAGIC[8] = { 'M', 'N', 'C', 'L', 'H', 'A', 'S', 'H' };
+}
+
+const uint32_t TranspositionTable::FILE_VERSION;
+
+TranspositionTable::TranspositionTable(size_t megabytes) : mask(0), generation(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    // Largest power of two number of buckets that fits the budget
+    size_t budget = megabytes * 1024 * 1024 / sizeof(Bucket);
+    size_t count = 1;
+    while (count * 2 <= budget) {
+        count *= 2;
+    }
+    
+    buckets.reset(new Bucket[count]);
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (uint64_t i = 0; i <= mask; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.check.store(EMPTY_DATA, std::memory_order_relaxed);
+            slot.data.store(EMPTY_DATA, std::memory_order_relaxed);
+        }
+    }
+}
+
+void TranspositionTable::newSearch() {
+    generation++;
+}
+
+bool TranspositionTable::save(const std::string& path, uint32_t id) const {
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FILE_VERSION;
+    header.id = id;
+    header.bucketCount = mask + 1;
+    header.generation = generation;
+    
+    // Every slot as its (check, data) pair
+    std::vector<uint64_t> words;
+    words.reserve(4 * (mask + 1));
+    for (uint64_t i = 0; i <= mask; i++) {
+        for (const Slot& slot : buckets[i].slots) {
+            words.push_back(slot.check.load(std::memory_order_relaxed));
+            words.push_back(slot.data.load(std::memory_order_relaxed));
+        }
+    }
+    
+    // Written next to the target and renamed over it only once complete, so
+    // an interrupted save leaves the previous table in place
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+        out.close();
+        if (!out) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    
+    // Windows will not rename over an existing file
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TranspositionTable::load(const std::string& path, uint32_t id) {
+    std::ifstream in(path, std::ios::binary);
+    FileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header.version == FILE_VERSION &&
+                 header.id == id &&
+                 header.bucketCount == mask + 1;
+    if (!valid) {
+        return false;
+    }
+    
+    std::vector<uint64_t> words(4 * (mask + 1));
+    if (!in.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(uint64_t))) {
+        return false;
+    }
+    
+    const uint64_t* word = words.data();
+    for (uint64_t i = 0; i <= mask; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.check.store(word[0], std::memory_order_relaxed);
+            slot.data.store(word[1], std::memory_order_relaxed);
+            word += 2;
+        }
+    }
+    generation = header.generation;
+    return true;
+}
+
+uint64_t TranspositionTable::pack(int depth, Bound bound, int score, int move, uint8_t generation) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(score))
+        | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 16
+        | static_cast<uint64_t>(static_cast<uint8_t>(bound)) << 24
+        | static_cast<uint64_t>(static_cast<uint8_t>(move)) << 32
+        | static_cast<uint64_t>(generation) << 40;
+}
+
+TTEntry TranspositionTable::unpack(uint64_t key, uint64_t data) {
+    TTEntry entry;
+    entry.key = key;
+    entry.score = static_cast<int16_t>(data & 0xFFFF);
+    entry.depth = static_cast<int8_t>((data >> 16) & 0xFF);
+    entry.bound = static_cast<Bound>((data >> 24) & 0xFF);
+    entry.move = static_cast<int8_t>((data >> 32) & 0xFF);
+    entry.generation = static_cast<uint8_t>((data >> 40) & 0xFF);
+    return entry;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    const Bucket& bucket = buckets[key & mask];
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == key) {
+            entry = unpack(key, data);
+            if (entry.depth >= 0) {
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, Bound bound, int score, int move) {
+    Bucket& bucket = buckets[key & mask];
+    
+    // Depth-preferred slot keeps the most expensive result of this search,
+    // otherwise fall back to the always-replace slot
+    Slot* target = &bucket.slots[1];
+    uint64_t slot0Data = bucket.slots[0].data.load(std::memory_order_relaxed);
+    uint64_t slot0Key = bucket.slots[0].check.load(std::memory_order_relaxed) ^ slot0Data;
+    TTEntry slot0 = unpack(slot0Key, slot0Data);
+    if (slot0Key == key || slot0.generation != generation || depth >= slot0.depth) {
+        target = &bucket.slots[0];
+    } else {
+        uint64_t slot1Data = bucket.slots[1].data.load(std::memory_order_relaxed);
+        uint64_t slot1Key = bucket.slots[1].check.load(std::memory_order_relaxed) ^ slot1Data;
+        if (slot1Key == key && depth < unpack(slot1Key, slot1Data).depth) {
+            return;  // Keep the deeper result for this position
+        }
+    }
+    
+    uint64_t data = pack(depth, bound, score, move, generation);
+    target->data.store(data, std::memory_order_relaxed);
+    target->check.store(key ^ data, std::memory_order_relaxed);
+}
@@ -0,0 +1,103 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// How a stored score relates to the true minimax value of the position
+enum class Bound : uint8_t {
+    EXACT,  // Score is the exact value
+    LOWER,  // Search failed high: value >= score
+    UPPER   // Search failed low: value <= score
+};
+
+struct TTEntry {
+    uint64_t key;       // Full Zobrist hash of the position
+    int16_t score;      // Score from the side to move's point of view
+    int8_t depth;       // Remaining depth the score was searched to
+    Bound bound;
+    int8_t move;        // Best move found, -1 if none
+    uint8_t generation; // Search that stored it, see newSearch
+};
+
+// Fixed-size hash table of search results keyed by Zobrist hash.
+//
+// The table is split into buckets of two entries. Replacement policy:
+// - slot 0 is depth-preferred: it is only overwritten by the same position
+//   or by a result searched at least as deep;
+// - slot 1 is always-replace: anything that does not go into slot 0
+//   lands here, so recent results are never dropped on the floor.
+// Probes check both slots of the bucket.
+//
+// Entries are kept from one search to the next. Each is tagged with the
+// generation of the search that stored it, and an entry left over from an
+// earlier search gives up the depth-preferred slot to anything new.
+//
+// The table is shared by all search threads without locks. Each slot holds
+// the packed entry data and the key XORed with that data, so a slot torn by
+// two concurrent writers fails the key check on probe instead of returning
+// mixed-up data.
+class TranspositionTable {
+public:
+    static const size_t DEFAULT_SIZE_MB = 4;
+    
+    explicit TranspositionTable(size_t megabytes = DEFAULT_SIZE_MB);
+    
+    // Change the memory budget; rounds down to a power-of-two bucket count
+    // and clears the table. Not safe while a search is running.
+    void resize(size_t megabytes);
+    
+    // Drop all entries. Not safe while a search is running.
+    void clear();
+    
+    // Start a new generation: entries stored so far become the first to be
+    // replaced, but can still be probed. Not safe while a search is running.
+    void newSearch();
+    
+    // Write the table to a file, or read one back. id tells apart tables of
+    // different searches (board variants); load fails on another id or
+    // another table size and then leaves the table as it was. save goes
+    // through path + ".tmp", so a failed save keeps the old file. Not safe
+    // while a search is running.
+    bool save(const std::string& path, uint32_t id) const;
+    bool load(const std::string& path, uint32_t id);
+    
+    // Look up a position; returns true and fills entry on a hit
+    bool probe(uint64_t key, TTEntry& entry) const;
+    
+    // Record a search result for a position
+    void store(uint64_t key, int depth, Bound bound, int score, int move);
+    
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;  // key ^ data
+        std::atomic<uint64_t> data;   // score, depth, bound, move and generation packed together
+    };
+    
+    struct Bucket {
+        Slot slots[2];
+    };
+    
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t id;
+        uint64_t bucketCount;
+        uint8_t generation;
+        uint8_t padding[7];
+    };
+    
+    static const uint32_t FILE_VERSION = 1;
+    
+    std::unique_ptr<Bucket[]> buckets;
+    uint64_t mask;
+    uint8_t generation;
+    
+    static uint64_t pack(int depth, Bound bound, int score, int move, uint8_t generation);
+    static TTEntry unpack(uint64_t key, uint64_t data);
+};
+
+#endif // TRANSPOSITION_H
@@ -0,0 +1,53 @@
+#include "turngen.h"
+#include <algorithm>
+
+template <class Board>
+void BasicTurnGenerator<Board>::generate(const Board& board, uint64_t hash, const Features& features, std::vector<Turn>& turns) {
+    turns.clear();
+    seen.clear();
+    
+    Turn start;
+    start.board = board;
+    start.hash = hash;
+    start.features = features;
+    start.length = 0;
+    expand(start, turns);
+}
+
+template <class Board>
+void BasicTurnGenerator<Board>::expand(const Turn& turn, std::vector<Turn>& turns) {
+    int moves[Board::PITS_PER_PLAYER];
+    int moveCount = turn.board.getPossibleMoves(moves);
+    
+    for (int i = 0; i < moveCount; i++) {
+        Turn next = turn;
+        typename Board::Undo undo;
+        next.board.makeMove(moves[i], undo, next.hash, next.features);
+        next.sowings[next.length++] = static_cast<int8_t>(moves[i]);
+        
+        // The first chain to reach a position stands for all of them
+        if (!visit(next.hash)) {
+            continue;
+        }
+        
+        // The turn ends when the other side is to move or the game is over
+        if (undo.turnFlipped || undo.swept) {
+            turns.push_back(next);
+        } else {
+            expand(next, turns);
+        }
+    }
+}
+
+template <class Board>
+bool BasicTurnGenerator<Board>::visit(uint64_t hash) {
+    if (std::find(seen.begin(), seen.end(), hash) != seen.end()) {
+        return false;
+    }
+    seen.push_back(hash);
+    return true;
+}
+
+#define INSTANTIATE_TURNS(PITS, STONES) template class BasicTurnGenerator<BasicMancala<PITS, STONES> >;
+MANCALA_VARIANTS(INSTANTIATE_TURNS)
+#undef INSTANTIATE_TURNS
@@ -0,0 +1,53 @@
+#ifndef TURNGEN_H
+#define TURNGEN_H
+
+#include "board.h"
+#include "evalfeatures.h"
+#include <cstdint>
+#include <vector>
+
+// One whole turn: a sowing plus every sowing its extra turns lead to, up to
+// the position where the other side is to move or the game has ended.
+// Holds the resulting position, so the search can step to it by copying.
+template <class Board>
+struct BasicTurn {
+    // Every sowing but the last of a turn ends in the mover's store
+    static const int MAX_SOWINGS = Board::TOTAL_STONES + 1;
+    
+    Board board;
+    uint64_t hash;
+    typename Board::Features features;
+    uint8_t length;                 // Sowings in the turn
+    int8_t sowings[MAX_SOWINGS];    // Pits sown, in order
+};
+
+// Expands the side to move's complete turns. Different chains of sowings
+// that reach the same position are merged into one turn, and a position
+// reached halfway through a chain is only expanded once, so the search
+// does not visit the same subtree twice through a reordered chain.
+template <class Board>
+class BasicTurnGenerator {
+public:
+    typedef BasicTurn<Board> Turn;
+    typedef typename Board::Features Features;
+    
+    // Replace turns with every distinct turn from board (with its Zobrist
+    // hash and evaluation features), in a fixed order for a given position.
+    // Empty if the side to move has no move.
+    void generate(const Board& board, uint64_t hash, const Features& features, std::vector<Turn>& turns);
+    
+private:
+    // Zobrist hashes of the positions expanded or produced by this generate call
+    std::vector<uint64_t> seen;
+    
+    // Continue the chain in turn (its board is to be sown from) with every move
+    void expand(const Turn& turn, std::vector<Turn>& turns);
+    
+    // Remember hash; false if it was seen already
+    bool visit(uint64_t hash);
+};
+
+typedef BasicTurn<MancalaBoard> Turn;
+typedef BasicTurnGenerator<MancalaBoard> TurnGenerator;
+
+#endif // TURNGEN_H
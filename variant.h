@@ -0,0 +1,36 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include "board.h"
+
+// Runtime choice between the board variants in MANCALA_VARIANTS. The
+// variant is picked once, here: visitor is called with the start position
+// of the matching BasicMancala instantiation, and everything it does with
+// that board (searching, sowing, ...) runs on the specialized code.
+//
+//     withVariant(6, 3, [&](auto board) {
+//         typedef decltype(board) Board;
+//         BasicMancalaAI<Board> ai;
+//         ...
+//     });
+//
+// Returns false, without calling visitor, for a variant that is not built.
+template <class Visitor>
+bool withVariant(int pits, int stones, Visitor&& visitor) {
+#define VISIT_VARIANT(PITS, STONES)              \
+    if (pits == PITS && stones == STONES) {      \
+        BasicMancala<PITS, STONES> board;        \
+        board.reset();                           \
+        visitor(board);                          \
+        return true;                             \
+    }
+    MANCALA_VARIANTS(VISIT_VARIANT)
+#undef VISIT_VARIANT
+    return false;
+}
+
+// The built variants as text, e.g. " 6,4 4,3", for usage messages
+#define MANCALA_VARIANT_NAME(PITS, STONES) " " #PITS "," #STONES
+#define MANCALA_VARIANT_NAMES MANCALA_VARIANTS(MANCALA_VARIANT_NAME)
+
+#endif // VARIANT_H
@@ -0,0 +1,60 @@
+#include "zobrist.h"
+
+namespace {
+    // Keys the standard board used before the table grew; they are still
+    // generated first so its hashes (and saved opening books) stay the same
+    const int STANDARD_PITS = MancalaBoard::TOTAL_PITS;
+    const int STANDARD_STONES = MancalaBoard::TOTAL_STONES;
+    
+    // splitmix64 with a fixed seed keeps hashes stable across runs
+    uint64_t nextKey(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+    
+    Zobrist::Keys generateKeys() {
+        Zobrist::Keys generated;
+        uint64_t state = 0x4d616e63616c6121ULL;
+        
+        for (int pit = 0; pit < STANDARD_PITS; pit++) {
+            for (int stones = 0; stones <= STANDARD_STONES; stones++) {
+                generated.pits[pit][stones] = nextKey(state);
+            }
+        }
+        generated.side = nextKey(state);
+        
+        // Stone counts only the larger variants reach
+        for (int pit = 0; pit < Zobrist::MAX_PITS; pit++) {
+            for (int stones = pit < STANDARD_PITS ? STANDARD_STONES + 1 : 0; stones <= Zobrist::MAX_STONES; stones++) {
+                generated.pits[pit][stones] = nextKey(state);
+            }
+        }
+        
+        return generated;
+    }
+}
+
+namespace Zobrist {
+    const Keys keys = generateKeys();
+    
+    template <class Board>
+    uint64_t hash(const Board& board) {
+        static_assert(Board::TOTAL_PITS <= MAX_PITS && Board::TOTAL_STONES <= MAX_STONES,
+                      "Zobrist keys do not cover this variant");
+        
+        uint64_t h = 0;
+        for (int pit = 0; pit < Board::TOTAL_PITS; pit++) {
+            h ^= pitKey(pit, board.pits[pit]);
+        }
+        if (!board.isPlayer1Turn()) {
+            h ^= sideKey();
+        }
+        return h;
+    }
+    
+#define INSTANTIATE_HASH(PITS, STONES) template uint64_t hash(const BasicMancala<PITS, STONES>&);
+    MANCALA_VARIANTS(INSTANTIATE_HASH)
+#undef INSTANTIATE_HASH
+}
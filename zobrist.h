@@ -0,0 +1,39 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "board.h"
+#include <cstdint>
+
+// Zobrist keys for the boards: one random key per (pit, stone count) pair
+// plus one for "Player 2 to move". The keys come from a fixed seed, so a
+// position hashes to the same value in every run. All variants share one
+// key table sized for the largest of them.
+namespace Zobrist {
+    // Large enough for every variant in MANCALA_VARIANTS
+    const int MAX_PITS = 14;
+    const int MAX_STONES = 72;
+    
+    struct Keys {
+        uint64_t pits[MAX_PITS][MAX_STONES + 1];
+        uint64_t side;
+    };
+    
+    extern const Keys keys;
+    
+    // Key for the given pit holding the given number of stones
+    inline uint64_t pitKey(int pit, int stones) {
+        return keys.pits[pit][stones];
+    }
+    
+    // Key XORed in when Player 2 is to move
+    inline uint64_t sideKey() {
+        return keys.side;
+    }
+    
+    // Full hash of a board, used at the search root and for debug checks.
+    // makeMove(pit, undo, hash) keeps it up to date incrementally.
+    template <class Board>
+    uint64_t hash(const Board& board);
+}
+
+#endif // ZOBRIST_H